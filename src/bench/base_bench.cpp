@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#include "base_bench.h"
+
+// The replacements of operator new and delete behind AllocationCount, in one
+// translation unit as the one-definition rule requires.
+
+// GCC pairs the malloc() and free() below with operator new and delete once
+// they are inlined into a container; they are a matched pair by design.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t size) {
+  s21::AllocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+// aligned_alloc() wants a size that is a multiple of the alignment
+void* operator new(size_t size, std::align_val_t alignment) {
+  s21::AllocationCount.fetch_add(1, std::memory_order_relaxed);
+  const size_t align = static_cast<size_t>(alignment);
+  const size_t rounded = (std::max<size_t>(size, 1) + align - 1) & ~(align - 1);
+  if (void* ptr = std::aligned_alloc(align, rounded)) return ptr;
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return operator new(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
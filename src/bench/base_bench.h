@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../decimal/decimal.h"
+
+#define RESET "\033[0m"
+#define GREEN "\033[32m"
+#define RED "\033[31m"
+
+namespace s21 {
+
+// Global allocation counter. operator new is replaced in base_bench.cpp, so
+// every heap allocation made by the measured code is visible to the harness.
+inline std::atomic<size_t> AllocationCount{0};
+
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+// Operand sets used by every benchmark case. Each distribution reflects a
+// class of values we actually see: counters, money, values at the edge of the
+// 96-bit mantissa and long fractions.
+class Distribution {
+ public:
+  enum Kind { SmallInt, Money, NearMax, Scale28 };
+
+  static constexpr Kind kAll[] = {SmallInt, Money, NearMax, Scale28};
+  static constexpr size_t kPoolSize = 1024;
+
+  explicit Distribution(Kind kind, uint64_t seed = 21) : kind_(kind) {
+    std::mt19937_64 rng(seed + kind);
+    values_.reserve(kPoolSize);
+    for (size_t i = 0; i < kPoolSize; ++i) {
+      values_.push_back(generate(rng));
+    }
+  }
+
+  const char* name() const noexcept {
+    switch (kind_) {
+      case SmallInt:
+        return "small_int";
+      case Money:
+        return "money";
+      case NearMax:
+        return "near_max";
+      default:
+        return "scale28";
+    }
+  }
+
+  const std::vector<Decimal>& values() const noexcept { return values_; }
+
+ private:
+  Kind kind_;
+  std::vector<Decimal> values_;
+
+  Decimal generate(std::mt19937_64& rng) const {
+    uint32_t sign = (rng() & 1) ? 0x80000000 : 0;
+    switch (kind_) {
+      case SmallInt:
+        return Decimal{static_cast<uint32_t>(rng() % 1000), 0, 0, sign};
+      case Money: {
+        // up to ten million units at scale 2..4
+        uint32_t scale = 2 + rng() % 3;
+        uint64_t units = rng() % 10000000;
+        for (uint32_t i = 0; i < scale; ++i) units *= 10;
+        units += rng() % 10000;
+        return Decimal{static_cast<uint32_t>(units),
+                       static_cast<uint32_t>(units >> 32), 0,
+                       sign | scale << 16};
+      }
+      case NearMax:
+        // within a few ULPs of 79228162514264337593543950335
+        return Decimal{0xFFFFFFFF - static_cast<uint32_t>(rng() % 1000),
+                       0xFFFFFFFF, 0xFFFFFFFF, sign};
+      default:
+        // 28 fractional digits below one
+        return Decimal{static_cast<uint32_t>(rng()),
+                       static_cast<uint32_t>(rng()),
+                       static_cast<uint32_t>(rng() % 0x204FCE5E),
+                       sign | 28U << 16};
+    }
+  }
+};
+
+struct BenchResult {
+  std::string name;
+  double ns_per_op;
+  double allocs_per_op;
+};
+
+class BaseBench {
+ public:
+  using Body = std::function<void(size_t)>;
+
+  static constexpr double kTargetSeconds = 0.02;
+  static constexpr int kRepeats = 5;
+
+  // Runs body(i) for i in [0, iterations) until the batch takes roughly
+  // kTargetSeconds, then reports the median of kRepeats batches. A body that
+  // processes several values per call passes their number as items, so that
+  // the result is still per value.
+  static void run(const std::string& name, const Body& body,
+                  size_t items = 1) {
+    if (name.find(filter_) == std::string::npos) return;
+
+    size_t iterations = 64;
+    while (true) {
+      double seconds = measure(body, iterations).first;
+      if (seconds >= kTargetSeconds || iterations >= (1UL << 30)) break;
+      iterations *= seconds > 0 ? std::max<size_t>(2, kTargetSeconds / seconds)
+                                : 16;
+    }
+
+    std::vector<double> samples;
+    size_t allocations = 0;
+    for (int i = 0; i < kRepeats; ++i) {
+      auto [seconds, allocs] = measure(body, iterations);
+      samples.push_back(seconds);
+      allocations = allocs;
+    }
+    std::sort(samples.begin(), samples.end());
+
+    BenchResult result{name, samples[kRepeats / 2] * 1e9 / iterations / items,
+                       static_cast<double>(allocations) / iterations / items};
+    results_.push_back(result);
+    printResult(result);
+  }
+
+  static void setFilter(const std::string& filter) { filter_ = filter; }
+
+  static void writeJson(const std::string& path) {
+    std::ofstream out(path);
+    out << "{\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results_.size(); ++i) {
+      out << "    {\"name\": \"" << results_[i].name << "\", \"ns_per_op\": "
+          << std::fixed << std::setprecision(2) << results_[i].ns_per_op
+          << ", \"allocs_per_op\": " << results_[i].allocs_per_op << "}"
+          << (i + 1 < results_.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+  }
+
+  // Reads a file produced by writeJson and prints the relative change of
+  // every benchmark present in both runs. Slowdowns above kRegression and
+  // any growth in allocations are printed in red.
+  static void compareWith(const std::string& path) {
+    std::map<std::string, BenchResult> baseline = readJson(path);
+    if (baseline.empty()) {
+      std::cout << "baseline " << path << " not found or empty" << std::endl;
+      return;
+    }
+
+    std::cout << std::endl << "Comparison with " << path << std::endl;
+    printSeparator();
+    for (const auto& result : results_) {
+      auto it = baseline.find(result.name);
+      if (it == baseline.end()) continue;
+      const BenchResult& base = it->second;
+      double change = (result.ns_per_op - base.ns_per_op) / base.ns_per_op;
+      bool regression = change > kRegression ||
+                        result.allocs_per_op > base.allocs_per_op + 1e-9;
+      std::cout << (regression ? RED : GREEN) << "| " << std::setw(28)
+                << std::left << result.name << " | " << std::setw(10)
+                << std::right << std::fixed << std::setprecision(2)
+                << base.ns_per_op << " -> " << std::setw(10)
+                << result.ns_per_op << " | " << std::showpos << std::setw(8)
+                << change * 100 << "%" << std::noshowpos << " |" << RESET
+                << std::endl;
+    }
+    std::cout << std::endl;
+  }
+
+  static void printHeader() {
+    printSeparator();
+    std::cout << "| " << std::setw(28) << std::left << "benchmark" << " | "
+              << std::setw(12) << std::right << "ns/op" << " | "
+              << std::setw(10) << "allocs/op" << " |" << std::endl;
+    printSeparator();
+  }
+
+ private:
+  static constexpr double kRegression = 0.10;
+  inline static std::vector<BenchResult> results_;
+  inline static std::string filter_;
+
+  static std::pair<double, size_t> measure(const Body& body,
+                                           size_t iterations) {
+    size_t allocations = AllocationCount.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+      body(i);
+    }
+    auto finish = std::chrono::steady_clock::now();
+    allocations = AllocationCount.load(std::memory_order_relaxed) - allocations;
+    return {std::chrono::duration<double>(finish - start).count(),
+            allocations};
+  }
+
+  static void printResult(const BenchResult& result) {
+    std::cout << "| " << std::setw(28) << std::left << result.name << " | "
+              << std::setw(12) << std::right << std::fixed
+              << std::setprecision(2) << result.ns_per_op << " | "
+              << std::setw(10) << result.allocs_per_op << " |" << std::endl;
+  }
+
+  static void printSeparator() {
+    std::cout << "-----------------------------------------------------------"
+              << std::endl;
+  }
+
+  static std::map<std::string, BenchResult> readJson(const std::string& path) {
+    std::map<std::string, BenchResult> result;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+      size_t name_pos = line.find("\"name\": \"");
+      if (name_pos == std::string::npos) continue;
+      name_pos += 9;
+      BenchResult entry;
+      entry.name = line.substr(name_pos, line.find('"', name_pos) - name_pos);
+      entry.ns_per_op = std::atof(
+          line.c_str() + line.find("\"ns_per_op\": ") + 13);
+      entry.allocs_per_op = std::atof(
+          line.c_str() + line.find("\"allocs_per_op\": ") + 17);
+      result[entry.name] = entry;
+    }
+    return result;
+  }
+};
+
+}  // namespace s21
@@ -0,0 +1,648 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <unordered_map>
+
+#include "../decimal/decimal_accumulator.h"
+#include "../decimal/decimal_batch.h"
+#include "../decimal/decimal_codec.h"
+#include "../decimal/decimal_column.h"
+#include "../decimal/decimal_file.h"
+#include "../decimal/decimal_map.h"
+#include "../decimal/decimal_parallel.h"
+#include "../decimal/decimal_parser.h"
+#include "../decimal/decimal_reader.h"
+#include "../decimal/decimal_sort.h"
+#include "../decimal/fixed_decimal.h"
+#include "base_bench.h"
+
+using namespace s21;
+
+namespace {
+
+// Inputs for the constructor benchmarks, derived from the same operand pool
+// so that every representation describes the same numbers.
+struct Inputs {
+  std::vector<Decimal> values;
+  std::vector<Decimal> others;
+  std::vector<std::string> strings;
+  std::vector<long> longs;
+  std::vector<float> floats;
+  std::vector<double> doubles;
+  std::vector<s21_decimal> s21_values;
+  std::vector<Decimal::OrderedKey> keys;
+  // the strings as one comma-separated column
+  std::string column;
+
+  explicit Inputs(const Distribution& distribution)
+      : values(distribution.values()) {
+    std::mt19937_64 rng(42);
+    others = values;
+    std::shuffle(others.begin(), others.end(), rng);
+    for (auto& other : others) {
+      if (other == Decimal()) other = Decimal(1L);
+    }
+
+    for (const auto& value : values) {
+      s21_decimal s21_d;
+      value.to_s21_decimal(&s21_d);
+      s21_values.push_back(s21_d);
+      keys.push_back(value.toOrderedKey());
+      strings.push_back(value.toString());
+      floats.push_back(value.toFloat().first);
+      doubles.push_back(value.toDouble().first);
+      long number = static_cast<long>(
+          (static_cast<uint64_t>(s21_d.bits[1]) << 32 | s21_d.bits[0]) >> 1);
+      longs.push_back(s21_d.bits[3] >> 31 ? -number : number);
+      column += strings.back() + ',';
+    }
+  }
+};
+
+constexpr size_t kMask = Distribution::kPoolSize - 1;
+
+void benchConstructors(const std::string& suffix, const Inputs& in) {
+  BaseBench::run("ctor_string/" + suffix, [&](size_t i) {
+    Decimal d(in.strings[i & kMask]);
+    DoNotOptimize(d);
+  });
+  BaseBench::run("fromChars/" + suffix, [&](size_t i) {
+    const std::string& str = in.strings[i & kMask];
+    Decimal d;
+    auto result = from_chars(str.data(), str.data() + str.size(), d);
+    DoNotOptimize(d);
+    DoNotOptimize(result);
+  });
+  BaseBench::run("ctor_long/" + suffix, [&](size_t i) {
+    Decimal d(in.longs[i & kMask]);
+    DoNotOptimize(d);
+  });
+  BaseBench::run("ctor_float/" + suffix, [&](size_t i) {
+    Decimal d(in.floats[i & kMask]);
+    DoNotOptimize(d);
+  });
+  BaseBench::run("ctor_double/" + suffix, [&](size_t i) {
+    Decimal d(in.doubles[i & kMask]);
+    DoNotOptimize(d);
+  });
+  BaseBench::run("ctor_s21_decimal/" + suffix, [&](size_t i) {
+    Decimal d(&in.s21_values[i & kMask]);
+    DoNotOptimize(d);
+  });
+  BaseBench::run("ctor_init_list/" + suffix, [&](size_t i) {
+    const uint32_t* bits = in.s21_values[i & kMask].bits;
+    Decimal d{bits[0], bits[1], bits[2], bits[3]};
+    DoNotOptimize(d);
+  });
+  BaseBench::run("ctor_copy/" + suffix, [&](size_t i) {
+    Decimal d(in.values[i & kMask]);
+    DoNotOptimize(d);
+  });
+}
+
+void benchParser(const std::string& suffix, const Inputs& in) {
+  std::vector<Decimal> out(Distribution::kPoolSize);
+  for (auto kernel : {DecimalParser::Scalar, DecimalParser::Sse42,
+                      DecimalParser::Avx2}) {
+    if (!DecimalParser::isSupported(kernel)) continue;
+    BaseBench::run(
+        std::string("parse_") + DecimalParser::kernelName(kernel) + "/" +
+            suffix,
+        [&](size_t) {
+          const char* text = in.column.data();
+          auto result = DecimalParser::parse(kernel, text,
+                                             text + in.column.size(), ',',
+                                             out.data(), out.size());
+          DoNotOptimize(result);
+          DoNotOptimize(out);
+        },
+        Distribution::kPoolSize);
+  }
+}
+
+void benchArithmetic(const std::string& suffix, const Inputs& in) {
+  BaseBench::run("add/" + suffix, [&](size_t i) {
+    Decimal d(in.values[i & kMask]);
+    d += in.others[i & kMask];
+    DoNotOptimize(d);
+  });
+  BaseBench::run("add_unchecked/" + suffix, [&](size_t i) {
+    Decimal d = unchecked::add(in.values[i & kMask], in.others[i & kMask]);
+    DoNotOptimize(d);
+  });
+  BaseBench::run("add_checked/" + suffix, [&](size_t i) {
+    Decimal d;
+    bool failed = checked::add(in.values[i & kMask], in.others[i & kMask], &d);
+    DoNotOptimize(failed);
+    DoNotOptimize(d);
+  });
+  BaseBench::run("sub/" + suffix, [&](size_t i) {
+    Decimal d(in.values[i & kMask]);
+    d -= in.others[i & kMask];
+    DoNotOptimize(d);
+  });
+  BaseBench::run("mul/" + suffix, [&](size_t i) {
+    Decimal d(in.values[i & kMask]);
+    d *= in.others[i & kMask];
+    DoNotOptimize(d);
+  });
+  BaseBench::run("mul_unchecked/" + suffix, [&](size_t i) {
+    Decimal d = unchecked::mul(in.values[i & kMask], in.others[i & kMask]);
+    DoNotOptimize(d);
+  });
+  BaseBench::run("div/" + suffix, [&](size_t i) {
+    Decimal d(in.values[i & kMask]);
+    d /= in.others[i & kMask];
+    DoNotOptimize(d);
+  });
+  BaseBench::run("mod/" + suffix, [&](size_t i) {
+    Decimal d(in.values[i & kMask]);
+    d %= in.others[i & kMask];
+    DoNotOptimize(d);
+  });
+  BaseBench::run("fma/" + suffix, [&](size_t i) {
+    Decimal d = Decimal::fma(in.values[i & kMask], in.others[i & kMask],
+                             in.values[(i + 1) & kMask]);
+    DoNotOptimize(d);
+  });
+  BaseBench::run("mul_add/" + suffix, [&](size_t i) {
+    Decimal d = in.values[i & kMask] * in.others[i & kMask] +
+                in.values[(i + 1) & kMask];
+    DoNotOptimize(d);
+  });
+  BaseBench::run("compare/" + suffix, [&](size_t i) {
+    int result = in.values[i & kMask].compare(in.others[i & kMask]);
+    DoNotOptimize(result);
+  });
+}
+
+// The same operations on FixedDecimal<4>, for values that fit that scale.
+void benchFixed(const std::string& suffix, const Inputs& in) {
+  using Price = FixedDecimal<4>;
+  std::vector<Price> values, others;
+  for (size_t i = 0; i < in.values.size(); ++i) {
+    values.push_back(Price::fromDecimal(in.values[i]).first);
+    others.push_back(Price::fromDecimal(in.others[i]).first);
+  }
+
+  BaseBench::run("fixed_add/" + suffix, [&](size_t i) {
+    Price d = values[i & kMask];
+    d += others[i & kMask];
+    DoNotOptimize(d);
+  });
+  BaseBench::run("fixed_mul/" + suffix, [&](size_t i) {
+    Price d = values[i & kMask];
+    d *= others[i & kMask];
+    DoNotOptimize(d);
+  });
+  BaseBench::run("fixed_compare/" + suffix, [&](size_t i) {
+    bool result = values[i & kMask] < others[i & kMask];
+    DoNotOptimize(result);
+  });
+  BaseBench::run("fixed_fromDecimal/" + suffix, [&](size_t i) {
+    auto result = Price::fromDecimal(in.values[i & kMask]);
+    DoNotOptimize(result);
+  });
+  BaseBench::run("fixed_toDecimal/" + suffix, [&](size_t i) {
+    Decimal d = values[i & kMask].toDecimal();
+    DoNotOptimize(d);
+  });
+}
+
+// The arithmetic above over the whole pool at once, per value.
+void benchBatch(const std::string& suffix, const Inputs& in) {
+  const Decimal* lhs = in.values.data();
+  const Decimal* rhs = in.others.data();
+  const size_t size = Distribution::kPoolSize;
+  std::vector<Decimal> out(size);
+  std::vector<uint8_t> errors(size);
+  std::vector<int8_t> order(size);
+  std::vector<Decimal::OrderedKey> keys(size);
+
+  BaseBench::run(
+      "batch_add/" + suffix,
+      [&](size_t) {
+        DecimalBatch::add(lhs, rhs, out.data(), size, errors.data());
+        DoNotOptimize(out);
+      },
+      size);
+  BaseBench::run(
+      "batch_mul/" + suffix,
+      [&](size_t) {
+        DecimalBatch::mul(lhs, rhs, out.data(), size, errors.data());
+        DoNotOptimize(out);
+      },
+      size);
+  BaseBench::run(
+      "batch_mul_scalar/" + suffix,
+      [&](size_t) {
+        DecimalBatch::mul(lhs, rhs[0], out.data(), size, errors.data());
+        DoNotOptimize(out);
+      },
+      size);
+  BaseBench::run(
+      "batch_div/" + suffix,
+      [&](size_t) {
+        DecimalBatch::div(lhs, rhs, out.data(), size, errors.data());
+        DoNotOptimize(out);
+      },
+      size);
+  BaseBench::run(
+      "batch_fma/" + suffix,
+      [&](size_t) {
+        DecimalBatch::fma(lhs, rhs, lhs[0], out.data(), size, errors.data());
+        DoNotOptimize(out);
+      },
+      size);
+  BaseBench::run(
+      "batch_compare/" + suffix,
+      [&](size_t) {
+        DecimalBatch::compare(lhs, rhs, order.data(), size);
+        DoNotOptimize(order);
+      },
+      size);
+  BaseBench::run(
+      "batch_to_keys/" + suffix,
+      [&](size_t) {
+        DecimalBatch::toOrderedKeys(lhs, keys.data(), size);
+        DoNotOptimize(keys);
+      },
+      size);
+  BaseBench::run(
+      "batch_from_keys/" + suffix,
+      [&](size_t) {
+        DecimalBatch::fromOrderedKeys(in.keys.data(), out.data(), size,
+                                      errors.data());
+        DoNotOptimize(out);
+      },
+      size);
+  BaseBench::run(
+      "batch_round/" + suffix,
+      [&](size_t) {
+        DecimalBatch::round(lhs, out.data(), size, errors.data());
+        DoNotOptimize(out);
+      },
+      size);
+}
+
+// Scans of the pool as a column and sums with an accumulator, per value,
+// against a loop of operator+=.
+void benchColumn(const std::string& suffix, const Inputs& in) {
+  DecimalColumn column;
+  for (const auto& value : in.values) column.push_back(value);
+  const size_t size = column.size();
+
+  BaseBench::run(
+      "column_sum/" + suffix,
+      [&](size_t) {
+        Decimal sum = column.sum();
+        DoNotOptimize(sum);
+      },
+      size);
+  BaseBench::run(
+      "column_max/" + suffix,
+      [&](size_t) {
+        Decimal max = column.max();
+        DoNotOptimize(max);
+      },
+      size);
+  BaseBench::run(
+      "column_get/" + suffix,
+      [&](size_t i) {
+        Decimal value = column[i & kMask];
+        DoNotOptimize(value);
+      });
+  BaseBench::run(
+      "accumulator_sum/" + suffix,
+      [&](size_t) {
+        DecimalAccumulator sum;
+        sum.add(in.values.data(), in.values.size());
+        Decimal result = sum.result();
+        DoNotOptimize(result);
+      },
+      size);
+  BaseBench::run(
+      "vector_sum/" + suffix,
+      [&](size_t) {
+        Decimal sum;
+        for (const auto& value : in.values) sum += value;
+        DoNotOptimize(sum);
+      },
+      size);
+}
+
+// Reductions over copies of the pool, long enough to be split into parts,
+// per value, with a part per hardware thread.
+void benchParallel(const std::string& suffix, const Inputs& in) {
+  constexpr size_t kCopies = 4 * DecimalParallel::kMinPart /
+                             Distribution::kPoolSize;
+  std::vector<Decimal> lhs, rhs;
+  for (size_t copy = 0; copy < kCopies; ++copy) {
+    lhs.insert(lhs.end(), in.values.begin(), in.values.end());
+    rhs.insert(rhs.end(), in.others.begin(), in.others.end());
+  }
+  const size_t size = lhs.size();
+
+  BaseBench::run(
+      "parallel_sum/" + suffix,
+      [&](size_t) {
+        Decimal sum = DecimalParallel::sum(lhs.data(), size);
+        DoNotOptimize(sum);
+      },
+      size);
+  BaseBench::run(
+      "parallel_max/" + suffix,
+      [&](size_t) {
+        Decimal max = DecimalParallel::max(lhs.data(), size);
+        DoNotOptimize(max);
+      },
+      size);
+  BaseBench::run(
+      "parallel_dot/" + suffix,
+      [&](size_t) {
+        Decimal dot = DecimalParallel::dot(lhs.data(), rhs.data(), size);
+        DoNotOptimize(dot);
+      },
+      size);
+}
+
+// Sorts of shuffled copies of the pool, against std::sort with operator<,
+// per value. Each run sorts a fresh copy, the copy is part of every case.
+void benchSort(const std::string& suffix, const Inputs& in) {
+  constexpr size_t kCopies = 4 * DecimalParallel::kMinPart /
+                             Distribution::kPoolSize;
+  std::vector<Decimal> values;
+  for (size_t copy = 0; copy < kCopies; ++copy) {
+    values.insert(values.end(), in.values.begin(), in.values.end());
+  }
+  std::shuffle(values.begin(), values.end(), std::mt19937_64(21));
+  const size_t size = values.size();
+  std::vector<Decimal> sorted(size);
+  std::vector<size_t> indices(size);
+
+  BaseBench::run(
+      "radix_sort/" + suffix,
+      [&](size_t) {
+        sorted = values;
+        DecimalSort::sort(sorted.data(), size);
+        DoNotOptimize(sorted);
+      },
+      size);
+  BaseBench::run(
+      "std_sort/" + suffix,
+      [&](size_t) {
+        sorted = values;
+        std::sort(sorted.begin(), sorted.end());
+        DoNotOptimize(sorted);
+      },
+      size);
+  BaseBench::run(
+      "argsort/" + suffix,
+      [&](size_t) {
+        DecimalSort::argsort(values.data(), size, indices.data());
+        DoNotOptimize(indices);
+      },
+      size);
+  BaseBench::run(
+      "parallel_sort/" + suffix,
+      [&](size_t) {
+        sorted = values;
+        DecimalSort::sort(sorted.data(), size, 0);
+        DoNotOptimize(sorted);
+      },
+      size);
+}
+
+// Encoding and decoding of the pool as one stream, per value: plain, and
+// delta at the largest scale of the pool.
+void benchCodec(const std::string& suffix, const Inputs& in) {
+  int scale = 0;
+  for (const s21_decimal& value : in.s21_values) {
+    scale = std::max(scale, static_cast<int>(value.bits[3] >> 16 & 0xFF));
+  }
+  const size_t size = in.values.size();
+  std::vector<Decimal> out(size);
+
+  for (auto mode : {DecimalEncoder::Plain, DecimalEncoder::Delta}) {
+    const std::string name =
+        mode == DecimalEncoder::Plain ? "codec_" : "codec_delta_";
+    DecimalEncoder encoder(mode, scale);
+    encoder.append(in.values.data(), size);
+    const std::vector<uint8_t> bytes(encoder.data(),
+                                     encoder.data() + encoder.size());
+
+    BaseBench::run(
+        name + "encode/" + suffix,
+        [&](size_t) {
+          DecimalEncoder fresh(mode, scale);
+          fresh.append(in.values.data(), size);
+          DoNotOptimize(fresh);
+        },
+        size);
+    BaseBench::run(
+        name + "decode/" + suffix,
+        [&](size_t) {
+          DecimalDecoder decoder(bytes.data(), bytes.size());
+          size_t count = decoder.decode(out.data(), size);
+          DoNotOptimize(count);
+          DoNotOptimize(out);
+        },
+        size);
+  }
+}
+
+// A column file of the pool: writing it, mapping it and reading every
+// value, and reads of single values from the mapping, per value.
+void benchFile(const std::string& suffix, const Inputs& in) {
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "s21_decimal_bench.bin")
+          .string();
+  const size_t size = in.values.size();
+  // the reads do not depend on the write case being run
+  DecimalFile::write(path, in.values.data(), size);
+
+  BaseBench::run(
+      "file_write/" + suffix,
+      [&](size_t) { DecimalFile::write(path, in.values.data(), size); },
+      size);
+  BaseBench::run(
+      "file_open_scan/" + suffix,
+      [&](size_t) {
+        DecimalFile file(path);
+        for (Decimal value : file) DoNotOptimize(value);
+      },
+      size);
+  DecimalFile file(path);
+  BaseBench::run("file_get/" + suffix, [&](size_t i) {
+    Decimal value = file[i & kMask];
+    DoNotOptimize(value);
+  });
+  std::filesystem::remove(path);
+}
+
+// Reading copies of the pool column from a text file, per value: the
+// streaming reader against splitting fields with std::getline and
+// Decimal(const std::string&).
+void benchReader(const std::string& suffix, const Inputs& in) {
+  constexpr size_t kCopies = 4 * DecimalParallel::kMinPart /
+                             Distribution::kPoolSize;
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "s21_decimal_bench.csv")
+          .string();
+  {
+    std::ofstream file(path, std::ios::binary);
+    for (size_t copy = 0; copy < kCopies; ++copy) file << in.column;
+  }
+  const size_t size = kCopies * Distribution::kPoolSize;
+  std::vector<Decimal> chunk(4096);
+
+  BaseBench::run(
+      "reader/" + suffix,
+      [&](size_t) {
+        DecimalReader reader(path);
+        while (reader.read(chunk.data(), chunk.size()) != 0) {
+          DoNotOptimize(chunk);
+        }
+      },
+      size);
+  BaseBench::run(
+      "getline_ctor/" + suffix,
+      [&](size_t) {
+        std::ifstream file(path, std::ios::binary);
+        std::string field;
+        while (std::getline(file, field, ',')) {
+          Decimal value(field);
+          DoNotOptimize(value);
+        }
+      },
+      size);
+  std::filesystem::remove(path);
+}
+
+// Lookups of the pool values keyed by price, against the standard maps, and
+// inserts of the whole pool into an empty map, per value.
+void benchMap(const std::string& suffix, const Inputs& in) {
+  DecimalMap<size_t> map;
+  std::map<Decimal, size_t> ordered;
+  std::unordered_map<Decimal, size_t> unordered;
+  for (size_t i = 0; i < in.values.size(); ++i) {
+    map[in.values[i]] = i;
+    ordered[in.values[i]] = i;
+    unordered[in.values[i]] = i;
+  }
+
+  BaseBench::run("map_find/" + suffix, [&](size_t i) {
+    const size_t* value = map.find(in.values[i & kMask]);
+    DoNotOptimize(value);
+  });
+  BaseBench::run("std_map_find/" + suffix, [&](size_t i) {
+    auto it = ordered.find(in.values[i & kMask]);
+    DoNotOptimize(it);
+  });
+  BaseBench::run("unordered_map_find/" + suffix, [&](size_t i) {
+    auto it = unordered.find(in.values[i & kMask]);
+    DoNotOptimize(it);
+  });
+  BaseBench::run(
+      "map_insert/" + suffix,
+      [&](size_t) {
+        DecimalMap<size_t> fresh;
+        for (size_t i = 0; i < in.values.size(); ++i) fresh[in.values[i]] = i;
+        DoNotOptimize(fresh);
+      },
+      in.values.size());
+}
+
+void benchOther(const std::string& suffix, const Inputs& in) {
+  BaseBench::run("round/" + suffix, [&](size_t i) {
+    Decimal d = in.values[i & kMask].round();
+    DoNotOptimize(d);
+  });
+  BaseBench::run("floor/" + suffix, [&](size_t i) {
+    Decimal d = in.values[i & kMask].floor();
+    DoNotOptimize(d);
+  });
+  BaseBench::run("truncate/" + suffix, [&](size_t i) {
+    Decimal d = in.values[i & kMask].truncate();
+    DoNotOptimize(d);
+  });
+}
+
+void benchConvertors(const std::string& suffix, const Inputs& in) {
+  BaseBench::run("toString/" + suffix, [&](size_t i) {
+    std::string str = in.values[i & kMask].toString();
+    DoNotOptimize(str);
+  });
+  BaseBench::run("toChars/" + suffix, [&](size_t i) {
+    char buffer[Decimal::kMaxStringLength];
+    auto result =
+        to_chars(buffer, buffer + sizeof(buffer), in.values[i & kMask]);
+    DoNotOptimize(buffer);
+    DoNotOptimize(result);
+  });
+  BaseBench::run("toInt/" + suffix, [&](size_t i) {
+    auto result = in.values[i & kMask].toInt();
+    DoNotOptimize(result);
+  });
+  BaseBench::run("toFloat/" + suffix, [&](size_t i) {
+    auto result = in.values[i & kMask].toFloat();
+    DoNotOptimize(result);
+  });
+  BaseBench::run("toDouble/" + suffix, [&](size_t i) {
+    auto result = in.values[i & kMask].toDouble();
+    DoNotOptimize(result);
+  });
+  BaseBench::run("toOrderedKey/" + suffix, [&](size_t i) {
+    Decimal::OrderedKey key = in.values[i & kMask].toOrderedKey();
+    DoNotOptimize(key);
+  });
+  BaseBench::run("fromOrderedKey/" + suffix, [&](size_t i) {
+    Decimal d = Decimal::fromOrderedKey(in.keys[i & kMask]);
+    DoNotOptimize(d);
+  });
+}
+
+}  // namespace
+
+// usage: bench [--json <output>] [--baseline <baseline>] [--filter <text>]
+int main(int argc, char** argv) try {
+  std::string json_path, baseline_path, filter;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (!std::strcmp(argv[i], "--json")) {
+      json_path = argv[i + 1];
+    } else if (!std::strcmp(argv[i], "--baseline")) {
+      baseline_path = argv[i + 1];
+    } else if (!std::strcmp(argv[i], "--filter")) {
+      filter = argv[i + 1];
+    }
+  }
+
+  BaseBench::setFilter(filter);
+  BaseBench::printHeader();
+  for (auto kind : Distribution::kAll) {
+    Distribution distribution(kind);
+    std::string suffix = distribution.name();
+    Inputs inputs(distribution);
+    benchConstructors(suffix, inputs);
+    benchParser(suffix, inputs);
+    benchArithmetic(suffix, inputs);
+    if (kind == Distribution::Money) benchFixed(suffix, inputs);
+    benchBatch(suffix, inputs);
+    benchColumn(suffix, inputs);
+    benchParallel(suffix, inputs);
+    benchSort(suffix, inputs);
+    benchCodec(suffix, inputs);
+    benchFile(suffix, inputs);
+    benchReader(suffix, inputs);
+    benchMap(suffix, inputs);
+    benchOther(suffix, inputs);
+    benchConvertors(suffix, inputs);
+  }
+
+  if (!json_path.empty()) BaseBench::writeJson(json_path);
+  if (!baseline_path.empty()) BaseBench::compareWith(baseline_path);
+
+} catch (const std::exception& e) {
+  std::cout << e.what() << std::endl;
+}
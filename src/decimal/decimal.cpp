@@ -1,250 +1,272 @@
 #include "decimal.h"
 
-namespace s21 {
-
-Decimal::Decimal(const std::string& input) : Decimal() {
-  fromString(input);
-  checkValue();
-  normalize();
-}
-
-Decimal::Decimal(const long& value) noexcept : Decimal() {
-  SignedMantissaType mantissa = static_cast<SignedMantissaType>(value);
-  if (mantissa < 0) {
-    mantissa *= -1;
-    sign_ = true;
-  }
-  mantissa_ = mantissa;
-}
-
-Decimal::Decimal(std::initializer_list<uint32_t> values) : error_(0) {
-  std::copy(values.begin(),
-            values.begin() + std::min(values.size(), static_cast<size_t>(4)),
-            bits_);
-  sign_ = (bits_[3] >> 31) & 1;
-  scale_ = (bits_[3] >> 16) & 0x1F;
-  bits_[3] &= ~(0x1F << 16);
-  bits_[3] &= ~(1U << 31);
-
-  checkValue();
-  normalize();
-}
-
-Decimal::Decimal(float value) : Decimal() {
-  std::ostringstream oss;
-  oss << std::scientific << std::setprecision(6) << value;
-  std::string str = oss.str();
-
-  int e_pos = str.find('e');
-  std::string mantissa_str = str.substr(0, e_pos);
-  std::string exponent = str.substr(e_pos + 1);
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string_view>
 
-  fromString(mantissa_str);
-  scale_ = 6 - std::stoi(exponent);
-
-  if (scale_ < 0) {
-    do {
-      mantissa_ *= 10;
-      ++scale_;
-    } while (!overflow(mantissa_) && scale_ < 0);
-  }
-
-  bool non_zero_value = mantissa_ > 0;
-  compression();
-  normalize();
-  checkValue();
-
-  if (mantissa_ == 0 && non_zero_value) {
-    error_ = UnderflowError;
-  }
-}
+namespace s21 {
 
-Decimal::Decimal(const s21_decimal* s21_d) noexcept : Decimal() {
-  const uint32_t* array = reinterpret_cast<const uint32_t*>(s21_d);
+namespace {
+
+using MantissaType = Decimal::MantissaType;
+
+using internal::bitLength;
+using internal::kChunkDigits;
+using internal::kMantissaBits;
+using internal::kMaxPowerOfTen;
+using internal::kMaxPowerOfTen64;
+using internal::kPowersOfTen;
+using internal::parseWhole;
+using internal::raiseScale;
+
+constexpr char kDigitPairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536"
+    "37383940414243444546474849505152535455565758596061626364656667686970717273"
+    "7475767778798081828384858687888990919293949596979899";
+
+// Writes value backwards ending at end, two digits per step, and returns the
+// first written character. A padded chunk always takes kChunkDigits digits.
+char* writeChunk(char* end, uint64_t value, bool padded) noexcept {
+  char* begin = end - (padded ? kChunkDigits : 0);
+  while (value >= 100) {
+    const char* pair = kDigitPairs + (value % 100) * 2;
+    value /= 100;
+    *--end = pair[1];
+    *--end = pair[0];
+  }
+  if (value >= 10) {
+    const char* pair = kDigitPairs + value * 2;
+    *--end = pair[1];
+    *--end = pair[0];
+  } else {
+    *--end = static_cast<char>('0' + value);
+  }
+  while (end > begin) *--end = '0';
+  return end;
+}
+
+// Significant digits kept by the floating point constructors, the same as
+// printf("%.6e") for float and printf("%.14e") for double.
+constexpr int kFloatPrecision = 7;
+constexpr int kDoublePrecision = 15;
+
+// A non-negative finite binary floating point value mantissa * 2^exponent.
+struct BinaryFloat {
+  uint64_t mantissa;
+  int exponent;
+};
+
+template <typename Float>
+BinaryFloat decompose(Float value) noexcept {
+  using Bits = std::conditional_t<sizeof(Float) == 4, uint32_t, uint64_t>;
+  constexpr int kFractionBits = std::numeric_limits<Float>::digits - 1;
+  constexpr int kBias = std::numeric_limits<Float>::max_exponent - 1;
+
+  Bits bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  uint64_t fraction = bits & ((static_cast<Bits>(1) << kFractionBits) - 1);
+  int biased = (bits >> kFractionBits) & (2 * kBias + 1);
+  if (biased == 0) {
+    return {fraction, 1 - kBias - kFractionBits};
+  }
+  return {fraction | static_cast<uint64_t>(1) << kFractionBits,
+          biased - kBias - kFractionBits};
+}
+
+// Rounds a positive value half to even to `precision` significant digits,
+// value ~ digits * 10^(exponent - precision + 1), using exact integer
+// arithmetic. Returns false if the intermediate values exceed 256 bits.
+bool roundSignificant(BinaryFloat value, int precision, uint64_t& digits,
+                      int& exponent) noexcept {
+  const uint64_t m = value.mantissa;
+  const int e = value.exponent;
+  const int bits = bitLength(m) + e;
+  const MantissaType lower = kPowersOfTen[precision - 1];
+  const MantissaType upper = kPowersOfTen[precision];
+
+  // value lies in [2^(bits - 1), 2^bits), so its decimal exponent is this
+  // estimate or the next one
+  int k = ((bits - 1) * 78913) >> 18;
+  for (int attempt = 0; attempt < 3; ++attempt) {
+    int q = k - precision + 1;
+    MantissaType result;
+    bool round_bit = false, sticky = false;
+    if (q >= 0) {
+      // value / 10^q, as a 128-bit division with remainder
+      if (q > kMaxPowerOfTen) return false;
+      MantissaType numerator = m, divisor = kPowersOfTen[q];
+      if (e >= 0) {
+        if (bits > kMantissaBits) return false;
+        numerator <<= e;
+      } else {
+        if (bitLength(divisor) - e > kMantissaBits) return false;
+        divisor <<= -e;
+      }
+      result = numerator / divisor;
+      MantissaType remainder = numerator % divisor;
+      round_bit = remainder >= divisor - remainder;
+      sticky = remainder != divisor - remainder;
+    } else if (-q > kMaxPowerOfTen) {
+      return false;
+    } else if (e >= 0) {
+      // an integer below 10^precision times 10^-q, exact
+      result = (static_cast<MantissaType>(m) << e) * kPowersOfTen[-q];
+    } else if (bitLength(m) + bitLength(kPowersOfTen[-q]) <= kMantissaBits &&
+               -e < kMantissaBits) {
+      // value * 10^-q = m * 10^-q / 2^-e, the product fits 128 bits
+      MantissaType scaled = m * kPowersOfTen[-q];
+      MantissaType half = static_cast<MantissaType>(1) << (-e - 1);
+      round_bit = scaled & half;
+      sticky = scaled & (half - 1);
+      result = scaled >> -e;
+    } else {
+      // the same with a 256-bit product
+      if (-e >= 256) return false;
+      UInt256 scaled = UInt256::multiply(m, kPowersOfTen[-q]);
+      sticky = scaled.shiftRight(-e - 1);
+      round_bit = scaled.limb(0) & 1;
+      scaled.shiftRight(1);
+      result = scaled.low128();
+    }
 
-  for (int i = 0; i < 3; ++i) {
-    bits_[i] = array[i];
+    if (result < lower) {
+      --k;
+    } else if (result >= upper) {
+      ++k;
+    } else {
+      if (round_bit && (sticky || (result & 1))) ++result;
+      if (result == upper) {
+        result = lower;
+        ++k;
+      }
+      digits = static_cast<uint64_t>(result);
+      exponent = k;
+      return true;
+    }
   }
-
-  sign_ = (array[3] >> 31) & 1;
-  scale_ = (array[3] >> 16) & 0x1F;
-
-  checkValue();
-  normalize();
-}
-
-Decimal::Decimal(const Decimal& d) noexcept
-    : mantissa_(d.mantissa_),
-      scale_(d.scale_),
-      sign_(d.sign_),
-      error_(d.error_) {
-  normalize();
-}
-
-Decimal& Decimal::operator=(const Decimal& d) noexcept {
-  if (this == &d) return *this;
-
-  mantissa_ = d.mantissa_;
-  scale_ = d.scale_;
-  sign_ = d.sign_;
-  error_ = d.error_;
-  normalize();
-
-  return *this;
-}
-
-Decimal& Decimal::operator=(const std::string& input) {
-  sign_ = false;
-  scale_ = 0;
-  mantissa_ = 0;
-  fromString(input);
-  checkValue();
-  normalize();
-  return *this;
+  return false;
 }
 
-int Decimal::compare(const Decimal& other) const noexcept {
-  if (this == &other) return 0;
-  if (mantissa_ == 0 && other.mantissa_ == 0) return 0;
-
-  if (sign_ && !other.sign_) {
-    return -1;
-  } else if (!sign_ && other.sign_) {
-    return 1;
-  }
-
-  Decimal lhs = *this;
-  Decimal rhs = other;
-  lhs.alignScales(rhs);
-
-  if (lhs.mantissa_ == rhs.mantissa_) {
-    return 0;
+// Significant digits of a non-negative finite value as printed by
+// printf("%.*e", precision - 1). The exact integer path covers every value
+// a Decimal can hold; far outside of that the library formatter is used.
+template <typename Float>
+void significantDigits(Float value, int precision, uint64_t& digits,
+                       int& exponent) noexcept {
+  digits = 0;
+  exponent = 0;
+  if (value == 0 ||
+      roundSignificant(decompose(value), precision, digits, exponent)) {
+    return;
   }
 
-  if (lhs.mantissa_ > rhs.mantissa_) {
-    return sign_ ? -1 : 1;
+  char buffer[32];
+  auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value,
+                                 std::chars_format::scientific, precision - 1);
+  const char* ptr = buffer;
+  for (; *ptr != 'e'; ++ptr) {
+    if (*ptr != '.') digits = digits * 10 + (*ptr - '0');
+  }
+  ptr += ptr[1] == '+' ? 2 : 1;
+  std::from_chars(ptr, end, exponent);
+}
+
+// Powers of ten exactly representable as a double; up to 10^10 also as a
+// float.
+constexpr double kExactPowersOfTen[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// Nearest Float to mantissa / 10^scale. Small operands are divided in
+// floating point directly. Otherwise the quotient is computed with at least
+// kQuotientBits bits and a sticky bit for the remainder, so the single
+// conversion to Float rounds it correctly.
+template <typename Float>
+Float toBinary(MantissaType mantissa, int scale, bool sign) noexcept {
+  constexpr int kQuotientBits = 66;
+  constexpr int kDigits = std::numeric_limits<Float>::digits;
+  constexpr int kExactPowers = kDigits < 53 ? 10 : 22;
+
+  Float result = 0;
+  if (mantissa < static_cast<MantissaType>(1) << kDigits &&
+      scale <= kExactPowers) {
+    // both operands are exact, so one division rounds correctly
+    result = static_cast<Float>(static_cast<uint64_t>(mantissa)) /
+             static_cast<Float>(kExactPowersOfTen[scale]);
   } else {
-    return sign_ ? 1 : -1;
+    int length = bitLength(mantissa);
+    int shift =
+        std::max(0, kQuotientBits + bitLength(kPowersOfTen[scale]) - length);
+    int pre_shift = std::min(shift, kMantissaBits - length);
+    UInt256 scaled =
+        UInt256::multiply(mantissa << pre_shift,
+                          static_cast<MantissaType>(1) << (shift - pre_shift));
+
+    bool sticky = false;
+    for (int digits = scale; digits > 0; digits -= kMaxPowerOfTen64) {
+      int step = std::min(digits, kMaxPowerOfTen64);
+      sticky |= scaled.divide(static_cast<uint64_t>(kPowersOfTen[step])) != 0;
+    }
+    int excess = std::max(0, scaled.bitLength() - 64);
+    sticky |= scaled.shiftRight(excess);
+    uint64_t quotient = static_cast<uint64_t>(scaled.low128()) | sticky;
+    result = std::ldexp(static_cast<Float>(quotient), excess - shift);
   }
+  return sign ? -result : result;
 }
 
-Decimal& Decimal::operator+=(const Decimal& other) {
-  calculate(other, 1);
-  checkValue();
-  return *this;
-}
+}  // namespace
 
-Decimal& Decimal::operator-=(const Decimal& other) {
-  calculate(other, -1);
-  checkValue();
-  return *this;
-}
+Decimal::Decimal(const std::string& input) : Decimal(parseWhole(input)) {}
 
-Decimal& Decimal::operator*=(const Decimal& other) {
-  if (error_) return *this;
-  if (other.error_) {
-    error_ = other.error_;
-    return *this;
-  }
-  sign_ = sign_ ^ other.sign_;
-  scale_ += other.scale_;
-
-  if (mantissa_ > 1 || other.mantissa_ > 1) {
-    multiplyWithClamping(other);
-  } else {
-    mantissa_ *= other.mantissa_;
-    compression(true);
-    normalize();
-    checkValue();
+Decimal::Decimal(float value) : Decimal() {
+  if (!std::isfinite(value)) {
+    throw std::invalid_argument("Non-finite floating point value");
   }
-
-  return *this;
+  uint64_t digits;
+  int exponent;
+  significantDigits(std::fabs(value), kFloatPrecision, digits, exponent);
+  assignRounded(digits, exponent, kFloatPrecision, std::signbit(value));
 }
 
-Decimal& Decimal::operator/=(const Decimal& other) {
-  if (error_) return *this;
-  if (other.error_) {
-    error_ = other.error_;
-    return *this;
-  }
-  if (other.mantissa_ == 0) {
-    error_ = DivisionByZeroError;
-    return *this;
-  }
-
-  if (mantissa_ == 0) {
-    normalize();
-    return *this;
-  }
-
-  sign_ = sign_ ^ other.sign_;
-  scale_ -= other.scale_;
-  auto result = mantissa_ / other.mantissa_;
-
-  mantissa_ %= other.mantissa_;
-
-  while (mantissa_ && !overflow(result) && scale_ < 29) {
-    mantissa_ *= 10;
-    result = result * 10 + mantissa_ / other.mantissa_;
-    mantissa_ %= other.mantissa_;
-    ++scale_;
+Decimal::Decimal(double value) : Decimal() {
+  if (!std::isfinite(value)) {
+    throw std::invalid_argument("Non-finite floating point value");
   }
+  uint64_t digits;
+  int exponent;
+  significantDigits(std::fabs(value), kDoublePrecision, digits, exponent);
+  assignRounded(digits, exponent, kDoublePrecision, std::signbit(value));
+}
 
-  if (overflow(result) || scale_ == 29) {
-    int remainder = result % 10;
-    result /= 10;
-    round_tail(result, remainder, !mantissa_);
-    --scale_;
-  }
+Decimal::Decimal(const s21_decimal* s21_d) noexcept : Decimal() {
+  const uint32_t* array = reinterpret_cast<const uint32_t*>(s21_d);
 
-  if (scale_ < 0) {
-    do {
-      result *= 10;
-      ++scale_;
-    } while (!overflow(result) && scale_ < 0);
+  MantissaType mantissa = 0;
+  for (int i = 2; i >= 0; --i) {
+    mantissa = mantissa << 32 | array[i];
   }
 
-  mantissa_ = result;
+  assign(mantissa, (array[3] >> 16) & 0x1F, (array[3] >> 31) & 1);
   normalize();
-  checkValue();
-
-  return *this;
 }
 
-Decimal& Decimal::operator%=(const Decimal& other) {
-  if (error_) return *this;
-  if (other.error_) {
-    error_ = other.error_;
-    return *this;
-  }
-  if (other.mantissa_ == 0) {
-    error_ = DivisionByZeroError;
-    return *this;
-  }
-
-  if (scale_ || other.scale_) {
-    error_ = ScaleError;
-    return *this;
-  }
-
-  if (mantissa_ == 0) {
-    normalize();
-    return *this;
-  }
-
-  sign_ = sign_ ^ other.sign_;
-  mantissa_ %= other.mantissa_;
-
+Decimal& Decimal::operator=(const std::string& input) {
+  *this = parseWhole(input);
   return *this;
 }
 
 void Decimal::printBitsUint() const noexcept {
-  if (error_) {
-    std::cout << "error " << error_ << std::endl;
+  if (error()) {
+    std::cout << "error " << error() << std::endl;
   } else {
     std::cout << "{ ";
     for (int i = 0; i < 3; ++i) {
-      std::cout << bits_[i] << ", ";
+      std::cout << getBits(i) << ", ";
     }
     std::cout << getSignAndScale();
     std::cout << " }" << std::endl;
@@ -252,13 +274,13 @@ void Decimal::printBitsUint() const noexcept {
 }
 
 void Decimal::printBitsHex() const noexcept {
-  if (error_) {
-    std::cout << "error " << error_ << std::endl;
+  if (error()) {
+    std::cout << "error " << error() << std::endl;
   } else {
     std::cout << std::hex << std::uppercase;
     std::cout << "{ ";
     for (int i = 0; i < 3; ++i) {
-      std::cout << "0x" << bits_[i] << ", ";
+      std::cout << "0x" << getBits(i) << ", ";
     }
     std::cout << "0x" << getSignAndScale();
     std::cout << " }" << std::endl;
@@ -272,41 +294,22 @@ void Decimal::printBitsBinary() const noexcept {
   std::cout << "| " << 3 << " | " << formatBinary(getSignAndScale()) << " |"
             << std::endl;
   for (int i = 2; i >= 0; --i) {
-    std::cout << "| " << i << " | " << formatBinary(bits_[i]) << " |"
+    std::cout << "| " << i << " | " << formatBinary(getBits(i)) << " |"
               << std::endl;
   }
   std::cout << std::endl;
 }
 
 std::string Decimal::toString() const noexcept {
-  if (error_) return "error " + std::to_string(error_);
-  std::string result;
-  MantissaType value = mantissa_;
-  if (value == 0) {
-    result.push_back('0');
-  }
-  while (value > 0) {
-    result.insert(result.begin(), '0' + (value % 10));
-    value /= 10;
-  }
-  if (scale_) {
-    size_t decimal_pos = result.size() - scale_;
-    if (scale_ >= static_cast<int>(result.size())) {
-      result = "0." + std::string(scale_ - result.size(), '0') + result;
-    } else {
-      result.insert(decimal_pos, ".");
-    }
-  }
-  if (sign_) {
-    result.insert(result.begin(), '-');
-  }
-  return result;
+  char buffer[kMaxStringLength];
+  auto result = to_chars(buffer, buffer + kMaxStringLength, *this);
+  return std::string(buffer, result.ptr);
 }
 
 std::pair<int, int> Decimal::toInt() const {
   Decimal trunc = truncate();
-  SignedMantissaType mantissa = trunc.mantissa_;
-  if (sign_) {
+  SignedMantissaType mantissa = trunc.mantissa();
+  if (sign()) {
     mantissa *= -1;
   }
   int result = static_cast<int>(mantissa);
@@ -321,127 +324,85 @@ std::pair<int, int> Decimal::toInt() const {
   return {result, err_code};
 }
 
-std::pair<float, int> Decimal::toFloat() const {
-  std::string str = toString();
-  float result;
-  int err_code = 0;
-
-  try {
-    result = std::stof(str);
-  } catch (...) {
-    err_code = ConvertationError;
-    ;
+std::pair<float, int> Decimal::toFloat() const noexcept {
+  if (error()) {
+    return {0, ConvertationError};
   }
+  return {toBinary<float>(mantissa(), scale(), sign()), NoErrors};
+}
 
-  return {result, err_code};
+std::pair<double, int> Decimal::toDouble() const noexcept {
+  if (error()) {
+    return {0, ConvertationError};
+  }
+  return {toBinary<double>(mantissa(), scale(), sign()), NoErrors};
 }
 
 void Decimal::to_s21_decimal(s21_decimal* s21_d) const noexcept {
   uint32_t* array = reinterpret_cast<uint32_t*>(s21_d);
 
   for (int i = 0; i < 3; ++i) {
-    array[i] = bits_[i];
+    array[i] = getBits(i);
   }
 
-  array[3] = (scale_ & 0xFF) << 16;
-  if (sign_) {
+  array[3] = (scale() & 0xFF) << 16;
+  if (sign()) {
     array[3] |= (1 << 31);
   }
 }
 
-Decimal Decimal::round() const noexcept {
-  if (!scale_) {
-    return *this;
-  }
-
-  Decimal result = *this;
-  int remainder;
-  int count = 0;
-
-  while (result.scale_ > 0) {
-    remainder = result.mantissa_ % 10;
-    result.mantissa_ /= 10;
-    ++count;
-    --result.scale_;
-  }
-
-  if (count) {
-    result.round_tail(result.mantissa_, remainder, false);
-  }
-
-  return result;
-}
-
-Decimal Decimal::floor() const noexcept {
-  if (!scale_) {
-    return *this;
+// Stores the value d.ddd * 10^exponent of digits, already rounded to
+// precision significant digits, rounded again to at most 28 fractional
+// digits. A non-zero value that rounds to zero is an UnderflowError.
+void Decimal::assignRounded(uint64_t digits, int exponent, int precision,
+                            bool sign) noexcept {
+  MantissaType mantissa = digits;
+  int scale = precision - 1 - exponent;
+  if (scale < 0) {
+    raiseScale(mantissa, scale, 0, true);
   }
 
-  Decimal result = truncate();
+  bool non_zero_value = mantissa > 0;
+  compression(mantissa, scale);
+  internal::normalize(mantissa, scale);
+  assign(mantissa, scale, sign);
 
-  if (result.sign_) {
-    ++result.mantissa_;
+  if (mantissa == 0 && non_zero_value) {
+    setError(UnderflowError);
   }
-
-  return result;
 }
 
-Decimal Decimal::truncate() const noexcept {
-  if (!scale_) {
-    return *this;
-  }
-
-  Decimal result = *this;
-  while (result.scale_ > 0) {
-    result.mantissa_ /= 10;
-    --result.scale_;
+uint32_t Decimal::getSignAndScale() const noexcept {
+  uint32_t result = (scale() & 0xFF) << 16;
+  if (sign()) {
+    result |= (1U << 31);
   }
 
-  return result;
-}
-
-Decimal Decimal::negate() const noexcept {
-  Decimal result = *this;
-  result.sign_ = !sign_;
+  result |= error();
 
   return result;
 }
 
-void Decimal::calculate(Decimal other, int8_t factor) {
-  if (error_) return;
-  if (other.error_) {
-    error_ = other.error_;
-    return;
-  }
-
-  alignScales(other);
-  SignedMantissaType mantissa = static_cast<SignedMantissaType>(mantissa_);
-  if (sign_) {
-    mantissa *= -1;
-  }
-  SignedMantissaType other_mantissa =
-      static_cast<SignedMantissaType>(other.mantissa_);
-  if (other.sign_) {
-    other_mantissa *= -1;
-  }
-  mantissa += other_mantissa * factor;
+std::string Decimal::formatBinary(uint32_t value) const noexcept {
+  std::bitset<32> binary(value);
+  std::string binaryStr = binary.to_string();
+  std::string formatted;
 
-  if (mantissa < 0) {
-    sign_ = true;
-    mantissa *= -1;
-  } else {
-    sign_ = false;
+  for (size_t j = 0; j < binaryStr.size(); ++j) {
+    formatted += binaryStr[j];
+    if ((j + 1) % 8 == 0 && j != binaryStr.size() - 1) {
+      formatted += " ";
+    }
   }
-  mantissa_ = mantissa;
-  compression(true);
-  normalize();
+  return formatted;
 }
 
-void Decimal::multiplyWithClamping(const Decimal& other) {
-  uint64_t high = mantissa_ >> 64;
-  uint64_t low = static_cast<uint64_t>(mantissa_);
-  uint64_t other_high = other.mantissa_ >> 64;
-  uint64_t other_low = static_cast<uint64_t>(other.mantissa_);
+#ifdef S21_DECIMAL_DEBUG_MULTIPLY
+void Decimal::multiplyWithTerm(const Decimal& other, int scale, bool sign) {
+  uint64_t high = mantissa() >> 64;
+  uint64_t low = static_cast<uint64_t>(mantissa());
+  uint64_t other_high = other.mantissa() >> 64;
+  uint64_t other_low = static_cast<uint64_t>(other.mantissa());
 
   auto low_low = static_cast<MantissaType>(low) * other_low;
   auto low_high = static_cast<MantissaType>(low) * other_high;
@@ -451,168 +412,27 @@ void Decimal::multiplyWithClamping(const Decimal& other) {
   Term t({{low_low, 0}, {low_high, 1}, {high_low, 1}, {high_high, 2}});
 
   bool success = t.data_->size() == 1;
-  while (scale_ && !success) {
+  while (scale && !success) {
     success = t.attempt();
-    --scale_;
+    --scale;
   }
 
   if (!success) {
-    if (sign_) {
-      error_ = NegativeOverflowError;
+    setSign(sign);
+    if (sign) {
+      setError(NegativeOverflowError);
       return;
     } else {
-      error_ = PositiveOverflowError;
+      setError(PositiveOverflowError);
       return;
     }
   }
 
-  mantissa_ = t.data_->front().first;
+  MantissaType mantissa = t.data_->front().first;
   bool remainder_discarded = t.carry_->size() == 0;
-  compression(remainder_discarded);
-  normalize();
-  checkValue();
-}
-
-void Decimal::normalize() noexcept {
-  if (error_) return;
-
-  if (mantissa_ == 0) {
-    // sign_ = false;
-    scale_ = 0;
-  }
-  while (mantissa_ % 10 == 0 && mantissa_ > 0 && scale_ > 0) {
-    mantissa_ /= 10;
-    scale_--;
-  }
-}
-
-void Decimal::round_tail(MantissaType& value, int remainder,
-                         bool bank_round) noexcept {
-  if (remainder == 5 && bank_round) {
-    if (value % 2 != 0) value++;
-  } else if (remainder > 4) {
-    value++;
-  }
-}
-
-void Decimal::compression(bool bank_round) noexcept {
-  int remainder;
-  int count = 0;
-
-  while (mantissa_ > 0 && scale_ > 28) {
-    remainder = mantissa_ % 10;
-    mantissa_ /= 10;
-    ++count;
-    --scale_;
-  }
-
-  while (overflow(mantissa_) && scale_ > 0) {
-    remainder = mantissa_ % 10;
-    mantissa_ /= 10;
-    ++count;
-    --scale_;
-  }
-
-  if (count) {
-    round_tail(mantissa_, remainder, count == 1 && bank_round);
-  }
-}
-
-uint32_t Decimal::getSignAndScale() const noexcept {
-  uint32_t result = (scale_ & 0xFF) << 16;
-  if (sign_) {
-    result |= (1U << 31);
-  }
-
-  result |= error_;
-
-  return result;
-}
-
-void Decimal::alignScales(Decimal& other) {
-  while (scale_ > other.scale_ && !overflow(other.mantissa_)) {
-    other.mantissa_ *= 10;
-    ++other.scale_;
-  }
-  while (scale_ < other.scale_ && !overflow(mantissa_)) {
-    mantissa_ *= 10;
-    ++scale_;
-  }
-
-  int remainder, count = 0;
-  if (scale_ > other.scale_) {
-    while (scale_ > other.scale_) {
-      remainder = mantissa_ % 10;
-      mantissa_ /= 10;
-      --scale_;
-      ++count;
-    }
-    round_tail(mantissa_, remainder, count == 1);
-  } else if (scale_ < other.scale_) {
-    while (scale_ < other.scale_) {
-      remainder = other.mantissa_ % 10;
-      other.mantissa_ /= 10;
-      --other.scale_;
-      ++count;
-    }
-    round_tail(mantissa_, remainder, count == 1);
-  }
-}
-
-bool Decimal::overflow(MantissaType value) const noexcept {
-  return (value >> 96) != 0;
-}
-
-void Decimal::checkValue() {
-  if (overflow(mantissa_)) {
-    if (sign_) {
-      error_ = NegativeOverflowError;
-      return;
-    } else {
-      error_ = PositiveOverflowError;
-      return;
-    }
-  }
-  if (scale_ < 0 || scale_ > 28) {
-    error_ = ScaleError;
-  }
-}
-
-void Decimal::fromString(const std::string& input) {
-  bool decimal_separator_found = false;
-  for (char ch : input) {
-    if (ch == '-') {
-      sign_ = true;
-    } else if (ch == '+') {
-      sign_ = false;
-    } else if (ch == '.') {
-      decimal_separator_found = true;
-    } else if (std::isdigit(ch)) {
-      mantissa_ = mantissa_ * 10 + (ch - '0');
-      if (decimal_separator_found) {
-        ++scale_;
-      }
-      if (overflow(mantissa_)) {
-        break;
-      }
-    } else {
-      throw std::invalid_argument("Invalid character in input string");
-    }
-  }
-}
-
-std::string Decimal::formatBinary(uint32_t value) const noexcept {
-  std::bitset<32> binary(value);
-  std::string binaryStr = binary.to_string();
-  std::string formatted;
-
-  for (size_t j = 0; j < binaryStr.size(); ++j) {
-    formatted += binaryStr[j];
-    if ((j + 1) % 8 == 0 && j != binaryStr.size() - 1) {
-      formatted += " ";
-    }
-  }
-  return formatted;
+  compression(mantissa, scale, remainder_discarded);
+  internal::normalize(mantissa, scale);
+  assign(mantissa, scale, sign);
 }
 
 Decimal::Term::Term(std::initializer_list<PairType> const& items)
@@ -666,44 +486,65 @@ void Decimal::Term::division_by_ten() {
 
   carry_->push_front(static_cast<int>(carry));
 }
+#endif
 
-std::ostream& operator<<(std::ostream& os, const Decimal& decimal) {
-  os << decimal.toString();
-  return os;
-}
-
-Decimal operator"" _d(const char* str, size_t) {
-  return Decimal(std::string(str));
-}
-
-Decimal operator+(const Decimal& lhs, const Decimal& rhs) {
-  Decimal result(lhs);
-  result += rhs;
-  return result;
-}
+std::to_chars_result to_chars(char* first, char* last,
+                              const Decimal& value) noexcept {
+  if (value.error()) {
+    constexpr std::string_view kPrefix = "error ";
+    if (last - first < static_cast<std::ptrdiff_t>(kPrefix.size())) {
+      return {last, std::errc::value_too_large};
+    }
+    first = std::copy(kPrefix.begin(), kPrefix.end(), first);
+    return std::to_chars(first, last, value.error());
+  }
+
+  // the 96-bit mantissa is printed as two 64-bit chunks of up to 19 digits
+  char digits[2 * kChunkDigits];
+  char* end = digits + sizeof(digits);
+  char* begin = end;
+  Decimal::MantissaType mantissa = value.mantissa();
+  if (mantissa >= kPowersOfTen[kChunkDigits]) {
+    Decimal::MantissaType high = mantissa / kPowersOfTen[kChunkDigits];
+    uint64_t low =
+        static_cast<uint64_t>(mantissa - high * kPowersOfTen[kChunkDigits]);
+    begin = writeChunk(end, low, true);
+    begin = writeChunk(begin, static_cast<uint64_t>(high), false);
+  } else {
+    begin = writeChunk(end, static_cast<uint64_t>(mantissa), false);
+  }
 
-Decimal operator-(const Decimal& lhs, const Decimal& rhs) {
-  Decimal result(lhs);
-  result -= rhs;
-  return result;
-}
+  int length = end - begin;
+  int scale = value.scale();
+  int integer_length = std::max(length - scale, 1);
+  int leading_zeros = std::max(scale - length, 0);
+  std::ptrdiff_t size =
+      value.sign() + integer_length + (scale > 0 ? 1 + scale : 0);
+  if (last - first < size) {
+    return {last, std::errc::value_too_large};
+  }
 
-Decimal operator*(const Decimal& lhs, const Decimal& rhs) {
-  Decimal result(lhs);
-  result *= rhs;
-  return result;
-}
+  if (value.sign()) *first++ = '-';
+  if (length > scale) {
+    first = std::copy(begin, end - scale, first);
+    begin = end - scale;
+  } else {
+    *first++ = '0';
+  }
+  if (scale > 0) {
+    *first++ = '.';
+    first = std::fill_n(first, leading_zeros, '0');
+    first = std::copy(begin, end, first);
+  }
 
-Decimal operator/(const Decimal& lhs, const Decimal& rhs) {
-  Decimal result(lhs);
-  result /= rhs;
-  return result;
+  return {first, std::errc()};
 }
 
-Decimal operator%(const Decimal& lhs, const Decimal& rhs) {
-  Decimal result(lhs);
-  result %= rhs;
-  return result;
+std::ostream& operator<<(std::ostream& os, const Decimal& decimal) {
+  char buffer[Decimal::kMaxStringLength];
+  auto result = to_chars(buffer, buffer + Decimal::kMaxStringLength, decimal);
+  os << std::string_view(buffer, result.ptr - buffer);
+  return os;
 }
 
 }  // namespace s21
\ No newline at end of file
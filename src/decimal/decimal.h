@@ -1,10 +1,21 @@
 #pragma once
 
+#include <array>
 #include <bitset>
-#include <deque>
+#include <charconv>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <string_view>
+#include <type_traits>
+
+#include "uint256.h"
+
+#ifdef S21_DECIMAL_DEBUG_MULTIPLY
+#include <deque>
 #include <list>
+#include <memory>
+#endif
 
 #define S21_PATH "../s21_decimal.h"
 
@@ -20,6 +31,28 @@ typedef struct {
 
 namespace s21 {
 
+class Decimal;
+
+namespace internal {
+
+class DecimalAccess;
+
+}  // namespace internal
+
+// The arithmetic operators without the error checks of their operands, for
+// inner loops over values validated up front, such as values whose
+// getErrorCode() was checked when they were parsed. An operand with an error
+// gives an unspecified result. The result is checked as by the operators:
+// an overflow or a division by zero still sets its error code.
+namespace unchecked {
+
+constexpr Decimal add(const Decimal& lhs, const Decimal& rhs);
+constexpr Decimal sub(const Decimal& lhs, const Decimal& rhs);
+constexpr Decimal mul(const Decimal& lhs, const Decimal& rhs);
+constexpr Decimal div(const Decimal& lhs, const Decimal& rhs);
+
+}  // namespace unchecked
+
 class Decimal {
  public:
   using MantissaType = __uint128_t;
@@ -35,45 +68,66 @@ class Decimal {
     ScaleError
   };
 
-  Decimal() noexcept : mantissa_(0), scale_(0), sign_(false), error_(0) {}
+#ifdef S21_DECIMAL_COMPACT
+  constexpr Decimal() noexcept : data_(0) {}
+#else
+  constexpr Decimal() noexcept
+      : mantissa_(0), scale_(0), sign_(false), error_(0) {}
+#endif
   explicit Decimal(const std::string& input);
-  Decimal(const long& value) noexcept;
-  Decimal(std::initializer_list<uint32_t> values);
+  constexpr Decimal(const long& value) noexcept;
+  constexpr Decimal(std::initializer_list<uint32_t> values);
+  // Rounds to 7 significant digits for float and 15 for double, then to
+  // at most 28 fractional digits. Throws std::invalid_argument for infinity
+  // and NaN.
   explicit Decimal(float value);
+  explicit Decimal(double value);
   explicit Decimal(const s21_decimal* s21_d) noexcept;
-  Decimal(const Decimal& d) noexcept;
 
-  Decimal& operator=(const Decimal& d) noexcept;
+  // Every value without an error is kept normalized by the operation that
+  // produced it, so copies and moves are plain memberwise copies.
+  constexpr Decimal(const Decimal& d) noexcept = default;
+  constexpr Decimal(Decimal&& d) noexcept = default;
+
+  constexpr Decimal& operator=(const Decimal& d) noexcept = default;
+  constexpr Decimal& operator=(Decimal&& d) noexcept = default;
   Decimal& operator=(const std::string& input);
 
-  int getErrorCode() const noexcept { return error_; }
-  int compare(const Decimal& other) const noexcept;
-  bool operator<(const Decimal& other) const noexcept {
+  constexpr int getErrorCode() const noexcept { return error(); }
+  constexpr int compare(const Decimal& other) const noexcept;
+  // Agrees with operator==: values that compare equal, such as 0 and -0,
+  // hash equal. The error code is not part of it.
+  constexpr size_t hash() const noexcept;
+  constexpr bool operator<(const Decimal& other) const noexcept {
     return compare(other) == -1;
   }
-  bool operator<=(const Decimal& other) const noexcept {
+  constexpr bool operator<=(const Decimal& other) const noexcept {
     return compare(other) < 1;
   }
-  bool operator>(const Decimal& other) const noexcept {
+  constexpr bool operator>(const Decimal& other) const noexcept {
     return compare(other) == 1;
   }
-  bool operator>=(const Decimal& other) const noexcept {
+  constexpr bool operator>=(const Decimal& other) const noexcept {
     return compare(other) > -1;
   }
-  bool operator==(const Decimal& other) const noexcept {
+  constexpr bool operator==(const Decimal& other) const noexcept {
     return compare(other) == 0;
   }
-  bool operator!=(const Decimal& other) const noexcept {
+  constexpr bool operator!=(const Decimal& other) const noexcept {
     return compare(other) != 0;
   }
 
-  Decimal& operator+=(const Decimal& other);
-  Decimal& operator-=(const Decimal& other);
-  Decimal& operator*=(const Decimal& other);
-  Decimal& operator/=(const Decimal& other);
-  Decimal& operator%=(const Decimal& other);
+  constexpr Decimal& operator+=(const Decimal& other);
+  constexpr Decimal& operator-=(const Decimal& other);
+  constexpr Decimal& operator*=(const Decimal& other);
+  constexpr Decimal& operator/=(const Decimal& other);
+  constexpr Decimal& operator%=(const Decimal& other);
 
-  void print() const { std::cout << toString() << std::endl; }
+  // longest text form: sign, 29 digits and the decimal point, or "-0."
+  // followed by 28 fractional digits
+  static constexpr int kMaxStringLength = 31;
+
+  void print() const { std::cout << *this << std::endl; }
 
   void printBitsUint() const noexcept;
   void printBitsHex() const noexcept;
@@ -81,41 +135,146 @@ class Decimal {
 
   std::string toString() const noexcept;
   std::pair<int, int> toInt() const;
-  std::pair<float, int> toFloat() const;
+  // Correctly rounded to the nearest float or double.
+  std::pair<float, int> toFloat() const noexcept;
+  std::pair<double, int> toDouble() const noexcept;
   void to_s21_decimal(s21_decimal* s21_d) const noexcept;
 
-  Decimal round() const noexcept;
-  Decimal floor() const noexcept;
-  Decimal truncate() const noexcept;
-  Decimal negate() const noexcept;
+  constexpr Decimal round() const noexcept;
+  constexpr Decimal floor() const noexcept;
+  constexpr Decimal truncate() const noexcept;
+  constexpr Decimal negate() const noexcept;
+
+  // Fixed-width key whose bytes compare with memcmp(), or as std::array,
+  // in the order of compare(): the sign, a biased decimal exponent and the
+  // digits aligned to 29 places, big-endian. Equal values such as 0 and -0
+  // get the same key. A value with an error gets a key above all others that
+  // keeps only its error code.
+  static constexpr int kOrderedKeySize = 16;
+  using OrderedKey = std::array<uint8_t, kOrderedKeySize>;
+  constexpr OrderedKey toOrderedKey() const noexcept;
+  // The normalized value of a key made by toOrderedKey(), ConvertationError
+  // for bytes that no value encodes to.
+  static constexpr Decimal fromOrderedKey(const OrderedKey& key) noexcept;
+
+  // a * b + c from the exact product, rounded once, half to even. The first
+  // operand with an error passes its code on as in a * b + c; otherwise the
+  // result is an overflow only if it leaves 96 bits, even where a * b alone
+  // would.
+  static constexpr Decimal fma(const Decimal& a, const Decimal& b,
+                               const Decimal& c) noexcept;
 
  private:
-  union {
-    MantissaType mantissa_;
-    struct {
-      uint32_t bits_[4];
-    };
-  };
+#ifdef S21_DECIMAL_COMPACT
+  // Compact 16-byte layout: bits 0..95 hold the mantissa and bits 96..127
+  // hold the s21_decimal sign/scale word, with the error code kept in its
+  // reserved low 16 bits. Intermediate results wider than 96 bits only live
+  // in locals, so an overflowed value keeps its error code but not its
+  // upper mantissa bits.
+  static constexpr int kWordShift = 96;
+  static constexpr MantissaType kMantissaMask =
+      (static_cast<MantissaType>(1) << kWordShift) - 1;
+
+  MantissaType data_;
 
+  constexpr MantissaType mantissa() const noexcept {
+    return data_ & kMantissaMask;
+  }
+  constexpr int scale() const noexcept {
+    return (data_ >> (kWordShift + 16)) & 0xFF;
+  }
+  constexpr bool sign() const noexcept { return data_ >> (kWordShift + 31); }
+  constexpr int error() const noexcept {
+    return (data_ >> kWordShift) & 0xFFFF;
+  }
+
+  constexpr void setMantissa(MantissaType mantissa) noexcept {
+    data_ = (data_ & ~kMantissaMask) | (mantissa & kMantissaMask);
+  }
+  constexpr void setScale(int scale) noexcept { setWordBits(scale, 16, 0xFF); }
+  constexpr void setSign(bool sign) noexcept { setWordBits(sign, 31, 1); }
+  constexpr void setError(int error) noexcept { setWordBits(error, 0, 0xFFFF); }
+  constexpr void setWordBits(uint32_t value, int shift,
+                             uint32_t mask) noexcept {
+    data_ &= ~(static_cast<MantissaType>(mask) << (kWordShift + shift));
+    data_ |= static_cast<MantissaType>(value & mask) << (kWordShift + shift);
+  }
+#else
+  MantissaType mantissa_;
   int scale_;
   bool sign_;
   int error_;
 
+  constexpr MantissaType mantissa() const noexcept { return mantissa_; }
+  constexpr int scale() const noexcept { return scale_; }
+  constexpr bool sign() const noexcept { return sign_; }
+  constexpr int error() const noexcept { return error_; }
+
+  constexpr void setMantissa(MantissaType mantissa) noexcept {
+    mantissa_ = mantissa;
+  }
+  constexpr void setScale(int scale) noexcept { scale_ = scale; }
+  constexpr void setSign(bool sign) noexcept { sign_ = sign; }
+  constexpr void setError(int error) noexcept { error_ = error; }
+#endif
+
   friend std::ostream& operator<<(std::ostream& os, const Decimal& decimal);
+  friend std::to_chars_result to_chars(char* first, char* last,
+                                       const Decimal& value) noexcept;
+  friend constexpr std::from_chars_result from_chars(const char* first,
+                                                     const char* last,
+                                                     Decimal& value) noexcept;
+  friend class internal::DecimalAccess;
+  friend constexpr Decimal unchecked::add(const Decimal& lhs,
+                                          const Decimal& rhs);
+  friend constexpr Decimal unchecked::sub(const Decimal& lhs,
+                                          const Decimal& rhs);
+  friend constexpr Decimal unchecked::mul(const Decimal& lhs,
+                                          const Decimal& rhs);
+  friend constexpr Decimal unchecked::div(const Decimal& lhs,
+                                          const Decimal& rhs);
+
+  uint32_t getBits(int index) const noexcept {
+    return static_cast<uint32_t>(mantissa() >> (32 * index));
+  }
 
-  void calculate(Decimal other, int8_t factor);
-  void multiplyWithClamping(const Decimal& other);
-  void normalize() noexcept;
-  void round_tail(MantissaType& value, int remainder,
-                  bool bank_round = false) noexcept;
-  void compression(bool bank_round = false) noexcept;
+  constexpr void calculate(const Decimal& other, int8_t factor);
+  // The operations behind +=, -=, *= and /= once both operands are known to
+  // be free of errors.
+  constexpr void calculateValue(const Decimal& other, int8_t factor) noexcept;
+  constexpr void multiplyValue(const Decimal& other);
+  constexpr void divideValue(const Decimal& other) noexcept;
+  constexpr void multiplyWithClamping(const Decimal& other, int scale,
+                                      bool sign);
+  constexpr void normalize() noexcept;
+  constexpr void assign(MantissaType mantissa, int scale, bool sign) noexcept;
+  // Rounds value * 10^-scale half to even to 28 fractional digits and 96
+  // bits, or sets an overflow error.
+  constexpr void assignWide(UInt256 value, int scale, bool sign) noexcept;
+  void assignRounded(uint64_t digits, int exponent, int precision,
+                     bool sign) noexcept;
   uint32_t getSignAndScale() const noexcept;
-  void alignScales(Decimal& other);
-  bool overflow(MantissaType value) const noexcept;
-  void checkValue();
-  void fromString(const std::string& input);
   std::string formatBinary(uint32_t value) const noexcept;
 
+  // Helpers working on an unpacked mantissa/scale pair, which may exceed
+  // 96 bits while an operation is in progress.
+  static constexpr void compression(MantissaType& mantissa, int& scale,
+                                    bool bank_round = false) noexcept;
+  static constexpr void alignScales(MantissaType& lhs, int& lhs_scale,
+                                    MantissaType& rhs,
+                                    int& rhs_scale) noexcept;
+  static constexpr int compareMagnitudes(MantissaType lhs, int lhs_scale,
+                                         MantissaType rhs,
+                                         int rhs_scale) noexcept;
+
+  // The ordered key as one 128-bit integer, most significant byte first.
+  constexpr MantissaType orderedWord() const noexcept;
+  static constexpr Decimal fromOrderedWord(MantissaType word) noexcept;
+
+#ifdef S21_DECIMAL_DEBUG_MULTIPLY
+  // Legacy list-based multiplication, kept to cross-check the 256-bit path.
+  void multiplyWithTerm(const Decimal& other, int scale, bool sign);
+
   // helper struct for multiplication with clamping
   struct Term {
     using PairType = std::pair<MantissaType, uint8_t>;
@@ -132,13 +291,76 @@ class Decimal {
     void enlargement();
     void division_by_ten();
   };
+#endif
 };
 
-Decimal operator"" _d(const char* str, size_t);
-Decimal operator+(const Decimal& lhs, const Decimal& rhs);
-Decimal operator-(const Decimal& lhs, const Decimal& rhs);
-Decimal operator*(const Decimal& lhs, const Decimal& rhs);
-Decimal operator/(const Decimal& lhs, const Decimal& rhs);
-Decimal operator%(const Decimal& lhs, const Decimal& rhs);
+static_assert(std::is_trivially_copyable_v<Decimal>,
+              "Decimal must stay trivially copyable");
+#ifdef S21_DECIMAL_COMPACT
+static_assert(sizeof(Decimal) == 16, "compact Decimal must fit 16 bytes");
+#endif
+
+// Writes the same text as toString() into [first, last) without allocating.
+// Returns errc::value_too_large and last if the range is too small;
+// kMaxStringLength characters are always enough.
+std::to_chars_result to_chars(char* first, char* last,
+                              const Decimal& value) noexcept;
+
+// Parses [+|-]digits[.digits] from the start of [first, last) without
+// allocating or throwing. Digits beyond the 28th fractional one or beyond
+// the 96-bit range are rounded half to even. Returns the end of the match
+// and:
+//  - errc::invalid_argument if there is no digit, value is left unchanged;
+//  - errc::result_out_of_range if the integer part does not fit, value gets
+//    PositiveOverflowError or NegativeOverflowError.
+constexpr std::from_chars_result from_chars(const char* first,
+                                            const char* last,
+                                            Decimal& value) noexcept;
+constexpr std::from_chars_result from_chars(std::string_view text,
+                                            Decimal& value) noexcept;
+
+// Parses like the string constructor. In a constant expression an invalid
+// string does not compile; at run time it throws std::invalid_argument.
+constexpr Decimal operator"" _d(const char* str, size_t size);
+
+// Numeric literal such as 12.34_dec or 1'000.50_dec, always evaluated at
+// compile time. Anything but digits[.digits] with an integer part within
+// 96 bits is a compile error; extra fractional digits are rounded as by
+// from_chars.
+template <char... Chars>
+constexpr Decimal operator"" _dec() noexcept;
+
+constexpr Decimal operator+(const Decimal& lhs, const Decimal& rhs);
+constexpr Decimal operator-(const Decimal& lhs, const Decimal& rhs);
+constexpr Decimal operator*(const Decimal& lhs, const Decimal& rhs);
+constexpr Decimal operator/(const Decimal& lhs, const Decimal& rhs);
+constexpr Decimal operator%(const Decimal& lhs, const Decimal& rhs);
+constexpr Decimal operator-(const Decimal& value) noexcept;
+
+// The arithmetic operators reporting failure the way __builtin_add_overflow
+// does: *result gets what the operator returns, and the return value is true
+// if it carries an error code, an overflow, a division by zero or the error
+// of an operand.
+namespace checked {
+
+constexpr bool add(const Decimal& lhs, const Decimal& rhs, Decimal* result);
+constexpr bool sub(const Decimal& lhs, const Decimal& rhs, Decimal* result);
+constexpr bool mul(const Decimal& lhs, const Decimal& rhs, Decimal* result);
+constexpr bool div(const Decimal& lhs, const Decimal& rhs, Decimal* result);
+
+}  // namespace checked
 
 }  // namespace s21
+
+namespace std {
+
+template <>
+struct hash<s21::Decimal> {
+  constexpr size_t operator()(const s21::Decimal& value) const noexcept {
+    return value.hash();
+  }
+};
+
+}  // namespace std
+
+#include "decimal_inl.h"
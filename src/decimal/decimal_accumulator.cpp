@@ -0,0 +1,81 @@
+#include "decimal_accumulator.h"
+
+#include <algorithm>
+
+namespace s21 {
+
+namespace {
+
+using internal::kMaxScale;
+using internal::kPowersOfTen;
+using internal::magnitude;
+using MantissaType = Decimal::MantissaType;
+using Access = internal::DecimalAccess;
+using SignedMantissaType = Decimal::SignedMantissaType;
+
+}  // namespace
+
+void DecimalAccumulator::add(const Decimal* values, size_t size) noexcept {
+  for (size_t i = 0; i < size;) {
+    // the terms up to the next carry, counted once
+    size_t last = i + std::min<size_t>(size - i, kCarryPeriod - pending_);
+    pending_ += static_cast<uint32_t>(last - i);
+    for (; i < last; ++i) {
+      const Decimal& value = values[i];
+      if (value.getErrorCode()) {
+        setError(value.getErrorCode());
+        continue;
+      }
+      SignedMantissaType mantissa = Access::mantissa(value);
+      partial_[Access::scale(value)] +=
+          Access::sign(value) ? -mantissa : mantissa;
+    }
+    if (pending_ == kCarryPeriod) carry();
+  }
+}
+
+void DecimalAccumulator::merge(const DecimalAccumulator& other) noexcept {
+  setError(other.error_);
+  for (int scale = 0; scale <= kMaxScale; ++scale) {
+    addWide(other.partial_[scale], scale);
+  }
+  positive_.add(other.positive_);
+  negative_.add(other.negative_);
+}
+
+Decimal DecimalAccumulator::result() const noexcept {
+  if (error_) {
+    Decimal result;
+    Access::setError(result, error_);
+    return result;
+  }
+
+  DecimalAccumulator total = *this;
+  total.carry();
+  Decimal result;
+  if (total.positive_.compare(total.negative_) < 0) {
+    total.negative_.subtract(total.positive_);
+    Access::assign(result, total.negative_, kMaxScale, true);
+  } else {
+    total.positive_.subtract(total.negative_);
+    Access::assign(result, total.positive_, kMaxScale, false);
+  }
+  return result;
+}
+
+void DecimalAccumulator::addWide(SignedMantissaType sum, int scale) noexcept {
+  if (sum == 0) return;
+  UInt256 term =
+      UInt256::multiply(magnitude(sum), kPowersOfTen[kMaxScale - scale]);
+  (sum < 0 ? negative_ : positive_).add(term);
+}
+
+void DecimalAccumulator::carry() noexcept {
+  for (int scale = 0; scale <= kMaxScale; ++scale) {
+    addWide(partial_[scale], scale);
+    partial_[scale] = 0;
+  }
+  pending_ = 0;
+}
+
+}  // namespace s21
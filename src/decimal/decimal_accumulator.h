@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "decimal.h"
+
+namespace s21 {
+
+// Exact running sum of Decimal values, rounded once when it is read. Unlike
+// a loop of operator+=, no term is aligned or rounded on the way and a total
+// that leaves 96 bits only overflows if it is still out of range at the end.
+//
+// Every term lands in a signed 128-bit partial sum for its scale, a plain
+// integer addition. The partial sums are carried into a 256-bit total at
+// scale 28 before they could overflow and when the result is read.
+//
+// The first term with an error makes it the error of the result.
+class DecimalAccumulator {
+ public:
+  DecimalAccumulator() noexcept = default;
+
+  DecimalAccumulator& operator+=(const Decimal& value) noexcept {
+    add(value, false);
+    return *this;
+  }
+  DecimalAccumulator& operator-=(const Decimal& value) noexcept {
+    add(value, true);
+    return *this;
+  }
+  void add(const Decimal* values, size_t size) noexcept;
+
+  // Adds the terms of other, as if they followed the terms of this one.
+  void merge(const DecimalAccumulator& other) noexcept;
+
+  // The sum rounded half to even to fit 96 bits, or an overflow error like
+  // the one of operator+.
+  Decimal result() const noexcept;
+  void clear() noexcept { *this = DecimalAccumulator(); }
+
+ private:
+  using MantissaType = Decimal::MantissaType;
+  using SignedMantissaType = Decimal::SignedMantissaType;
+  using Access = internal::DecimalAccess;
+
+  // Terms added to the partial sums between two carries: 2^31 terms below
+  // 2^96 cannot overflow 128 bits.
+  static constexpr uint32_t kCarryPeriod = uint32_t{1} << 31;
+
+  SignedMantissaType partial_[internal::kMaxScale + 1] = {};
+  uint32_t pending_ = 0;
+  int error_ = Decimal::NoErrors;
+  // the total as a magnitude of each sign
+  UInt256 positive_;
+  UInt256 negative_;
+
+  friend class DecimalColumn;
+  friend class DecimalParallel;
+
+  void add(const Decimal& value, bool negate) noexcept {
+    if (value.getErrorCode()) {
+      setError(value.getErrorCode());
+      return;
+    }
+    addTerm(Access::mantissa(value), Access::scale(value),
+            Access::sign(value) != negate);
+  }
+  // Adds a term below 2^96 with a scale within 0..28.
+  void addTerm(MantissaType mantissa, int scale, bool negative) noexcept {
+    SignedMantissaType value = mantissa;
+    partial_[scale] += negative ? -value : value;
+    if (++pending_ == kCarryPeriod) carry();
+  }
+  // Adds sum * 10^-scale to the total; any 128-bit sum is accepted.
+  void addWide(SignedMantissaType sum, int scale) noexcept;
+  void carry() noexcept;
+  void setError(int error) noexcept {
+    if (!error_) error_ = error;
+  }
+};
+
+}  // namespace s21
@@ -0,0 +1,344 @@
+#include "decimal_batch.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace s21 {
+
+namespace {
+
+using internal::kMaxPowerOfTen64;
+using internal::kMaxScale;
+using internal::kOverflowThresholds;
+using MantissaType = Decimal::MantissaType;
+using Access = internal::DecimalAccess;
+using internal::kPowersOfTen;
+using internal::magnitude;
+using internal::withSign;
+using SignedMantissaType = Decimal::SignedMantissaType;
+
+// Values rounded with one kernel: large enough to amortize the scale check,
+// small enough to stay in L1 between the check and the rounding.
+constexpr size_t kBlock = 256;
+
+// Multiplies value by 10^digits, false if the product leaves 96 bits.
+constexpr bool raise(MantissaType& value, int digits) {
+  if (value >= kOverflowThresholds[digits]) return false;
+  value *= kPowersOfTen[digits];
+  return true;
+}
+
+}  // namespace
+
+size_t DecimalBatch::add(const Decimal* lhs, const Decimal* rhs, Decimal* out,
+                         size_t size, uint8_t* errors) noexcept {
+  return apply<Add>({lhs, 1}, {rhs, 1}, out, size, errors);
+}
+
+size_t DecimalBatch::add(const Decimal* lhs, const Decimal& rhs, Decimal* out,
+                         size_t size, uint8_t* errors) noexcept {
+  // a copy, as out may overlap the broadcast value
+  Decimal value = rhs;
+  return apply<Add>({lhs, 1}, {&value, 0}, out, size, errors);
+}
+
+size_t DecimalBatch::sub(const Decimal* lhs, const Decimal* rhs, Decimal* out,
+                         size_t size, uint8_t* errors) noexcept {
+  return apply<Sub>({lhs, 1}, {rhs, 1}, out, size, errors);
+}
+
+size_t DecimalBatch::sub(const Decimal* lhs, const Decimal& rhs, Decimal* out,
+                         size_t size, uint8_t* errors) noexcept {
+  Decimal value = rhs;
+  return apply<Sub>({lhs, 1}, {&value, 0}, out, size, errors);
+}
+
+size_t DecimalBatch::mul(const Decimal* lhs, const Decimal* rhs, Decimal* out,
+                         size_t size, uint8_t* errors) noexcept {
+  return apply<Mul>({lhs, 1}, {rhs, 1}, out, size, errors);
+}
+
+size_t DecimalBatch::mul(const Decimal* lhs, const Decimal& rhs, Decimal* out,
+                         size_t size, uint8_t* errors) noexcept {
+  Decimal value = rhs;
+  return apply<Mul>({lhs, 1}, {&value, 0}, out, size, errors);
+}
+
+size_t DecimalBatch::div(const Decimal* lhs, const Decimal* rhs, Decimal* out,
+                         size_t size, uint8_t* errors) noexcept {
+  return apply<Div>({lhs, 1}, {rhs, 1}, out, size, errors);
+}
+
+size_t DecimalBatch::div(const Decimal* lhs, const Decimal& rhs, Decimal* out,
+                         size_t size, uint8_t* errors) noexcept {
+  Decimal value = rhs;
+  return apply<Div>({lhs, 1}, {&value, 0}, out, size, errors);
+}
+
+size_t DecimalBatch::fma(const Decimal* lhs, const Decimal* rhs,
+                         const Decimal* addend, Decimal* out, size_t size,
+                         uint8_t* errors) noexcept {
+  return fmaAll({lhs, 1}, {rhs, 1}, {addend, 1}, out, size, errors);
+}
+
+size_t DecimalBatch::fma(const Decimal* lhs, const Decimal* rhs,
+                         const Decimal& addend, Decimal* out, size_t size,
+                         uint8_t* errors) noexcept {
+  Decimal value = addend;
+  return fmaAll({lhs, 1}, {rhs, 1}, {&value, 0}, out, size, errors);
+}
+
+void DecimalBatch::toOrderedKeys(const Decimal* values,
+                                 Decimal::OrderedKey* out,
+                                 size_t size) noexcept {
+  for (size_t i = 0; i < size; ++i) out[i] = values[i].toOrderedKey();
+}
+
+size_t DecimalBatch::fromOrderedKeys(const Decimal::OrderedKey* keys,
+                                     Decimal* out, size_t size,
+                                     uint8_t* errors) noexcept {
+  size_t failed = 0;
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = Decimal::fromOrderedKey(keys[i]);
+
+    int error = out[i].getErrorCode();
+    if (errors) errors[i] = static_cast<uint8_t>(error);
+    failed += error != 0;
+  }
+  return failed;
+}
+
+void DecimalBatch::compare(const Decimal* lhs, const Decimal* rhs, int8_t* out,
+                           size_t size) noexcept {
+  compareAll({lhs, 1}, {rhs, 1}, out, size);
+}
+
+void DecimalBatch::compare(const Decimal* lhs, const Decimal& rhs, int8_t* out,
+                           size_t size) noexcept {
+  Decimal value = rhs;
+  compareAll({lhs, 1}, {&value, 0}, out, size);
+}
+
+template <size_t... kScales>
+constexpr std::array<DecimalBatch::RoundKernel, sizeof...(kScales)>
+DecimalBatch::roundKernels(std::index_sequence<kScales...>) noexcept {
+  return {&roundShared<static_cast<int>(kScales)>...};
+}
+
+size_t DecimalBatch::round(const Decimal* values, Decimal* out, size_t size,
+                           uint8_t* errors) noexcept {
+  static constexpr auto kKernels =
+      roundKernels(std::make_index_sequence<kMaxScale + 1>());
+
+  size_t failed = 0;
+  for (size_t first = 0; first < size; first += kBlock) {
+    size_t last = std::min(size, first + kBlock);
+    int scale = sharedScale(values + first, last - first);
+    if (scale >= 0) {
+      kKernels[scale](values + first, out + first, last - first);
+    } else {
+      for (size_t i = first; i < last; ++i) {
+        int element_scale = Access::scale(values[i]);
+        if (element_scale <= kMaxScale) {
+          kKernels[element_scale](values + i, out + i, 1);
+        } else {
+          out[i] = values[i].round();
+        }
+      }
+    }
+    for (size_t i = first; i < last; ++i) {
+      int error = out[i].getErrorCode();
+      if (errors) errors[i] = static_cast<uint8_t>(error);
+      failed += error != 0;
+    }
+  }
+  return failed;
+}
+
+template <DecimalBatch::Operation kOp>
+size_t DecimalBatch::apply(Operand lhs, Operand rhs, Decimal* out,
+                           size_t size, uint8_t* errors) noexcept {
+  size_t failed = 0;
+  for (size_t i = 0; i < size; ++i) {
+    const Decimal& left = lhs[i];
+    const Decimal& right = rhs[i];
+    // the integer paths set the fields of out[i], see roundShared()
+    bool done = false;
+    if constexpr (kOp != Div) {
+      if ((left.getErrorCode() | right.getErrorCode()) == 0) {
+        if constexpr (kOp == Mul) {
+          done = mulNarrow(left, right, out[i]);
+        } else {
+          done = addAligned(left, right, kOp == Sub, out[i]);
+        }
+      }
+    }
+    if (!done) {
+      // out[i] may be one of the operands
+      Decimal result = left;
+      if constexpr (kOp == Add) result += right;
+      if constexpr (kOp == Sub) result -= right;
+      if constexpr (kOp == Mul) result *= right;
+      if constexpr (kOp == Div) result /= right;
+      out[i] = result;
+    }
+
+    int error = out[i].getErrorCode();
+    if (errors) errors[i] = static_cast<uint8_t>(error);
+    failed += error != 0;
+  }
+  return failed;
+}
+
+size_t DecimalBatch::fmaAll(Operand lhs, Operand rhs, Operand addend,
+                            Decimal* out, size_t size,
+                            uint8_t* errors) noexcept {
+  size_t failed = 0;
+  for (size_t i = 0; i < size; ++i) {
+    const Decimal& left = lhs[i];
+    const Decimal& right = rhs[i];
+    const Decimal& term = addend[i];
+    if ((left.getErrorCode() | right.getErrorCode() | term.getErrorCode()) !=
+            0 ||
+        !fmaNarrow(left, right, term, out[i])) {
+      out[i] = Decimal::fma(left, right, term);
+    }
+
+    int error = out[i].getErrorCode();
+    if (errors) errors[i] = static_cast<uint8_t>(error);
+    failed += error != 0;
+  }
+  return failed;
+}
+
+void DecimalBatch::compareAll(Operand lhs, Operand rhs, int8_t* out,
+                              size_t size) noexcept {
+  // the scalar comparison of different scales mostly stops at the signs or
+  // the bit lengths already, so only equal scales take the integer path
+  for (size_t i = 0; i < size; ++i) {
+    const Decimal& left = lhs[i];
+    const Decimal& right = rhs[i];
+    if (((Access::scale(left) ^ Access::scale(right)) | left.getErrorCode() |
+         right.getErrorCode()) == 0) {
+      SignedMantissaType lhs_value =
+          withSign(Access::mantissa(left), Access::sign(left));
+      SignedMantissaType rhs_value =
+          withSign(Access::mantissa(right), Access::sign(right));
+      out[i] = static_cast<int8_t>((lhs_value > rhs_value) -
+                                   (lhs_value < rhs_value));
+    } else {
+      out[i] = static_cast<int8_t>(left.compare(right));
+    }
+  }
+}
+
+int DecimalBatch::sharedScale(const Decimal* values, size_t size) noexcept {
+  // no early exit, so that the check stays a branch-free reduction
+  int scale = Access::scale(values[0]);
+  int mismatch = 0;
+  for (size_t i = 0; i < size; ++i) {
+    mismatch |= (Access::scale(values[i]) ^ scale) | values[i].getErrorCode();
+  }
+  return mismatch ? -1 : scale;
+}
+
+__attribute__((always_inline)) inline bool DecimalBatch::addAligned(
+    const Decimal& lhs, const Decimal& rhs, bool negate,
+    Decimal& result) noexcept {
+  return sumAligned(Access::mantissa(lhs), Access::scale(lhs),
+                    Access::sign(lhs), Access::mantissa(rhs),
+                    Access::scale(rhs), Access::sign(rhs) != negate, result);
+}
+
+__attribute__((always_inline)) inline bool DecimalBatch::mulNarrow(
+    const Decimal& lhs, const Decimal& rhs, Decimal& result) noexcept {
+  MantissaType lhs_mantissa = Access::mantissa(lhs);
+  MantissaType rhs_mantissa = Access::mantissa(rhs);
+  int scale = Access::scale(lhs) + Access::scale(rhs);
+  if (scale > kMaxScale || (lhs_mantissa | rhs_mantissa) >> 64) return false;
+
+  MantissaType mantissa = static_cast<MantissaType>(
+                              static_cast<uint64_t>(lhs_mantissa)) *
+                          static_cast<uint64_t>(rhs_mantissa);
+  if (internal::overflow(mantissa)) return false;
+
+  bool sign = Access::sign(lhs) != Access::sign(rhs);
+  internal::normalize(mantissa, scale);
+  Access::setError(result, Decimal::NoErrors);
+  Access::assign(result, mantissa, scale, sign);
+  return true;
+}
+
+// An exact product within 96 bits plus the addend: nothing to round, so the
+// sum is what Decimal::fma() returns.
+inline bool DecimalBatch::fmaNarrow(const Decimal& lhs, const Decimal& rhs,
+                                    const Decimal& addend,
+                                    Decimal& result) noexcept {
+  MantissaType lhs_mantissa = Access::mantissa(lhs);
+  MantissaType rhs_mantissa = Access::mantissa(rhs);
+  int scale = Access::scale(lhs) + Access::scale(rhs);
+  if (scale > kMaxScale || (lhs_mantissa | rhs_mantissa) >> 64) return false;
+
+  MantissaType product = static_cast<MantissaType>(
+                             static_cast<uint64_t>(lhs_mantissa)) *
+                         static_cast<uint64_t>(rhs_mantissa);
+  if (internal::overflow(product)) return false;
+  return sumAligned(product, scale, Access::sign(lhs) != Access::sign(rhs),
+                    Access::mantissa(addend), Access::scale(addend),
+                    Access::sign(addend), result);
+}
+
+__attribute__((always_inline)) inline bool DecimalBatch::sumAligned(
+    MantissaType lhs, int lhs_scale, bool lhs_sign, MantissaType rhs,
+    int rhs_scale, bool rhs_sign, Decimal& result) noexcept {
+  int digits = lhs_scale - rhs_scale;
+  // equal scales, the common case within a column, need no alignment; the
+  // scalar operator would round an operand that leaves 96 bits
+  if (digits > 0 && !raise(rhs, digits)) return false;
+  if (digits < 0 && !raise(lhs, -digits)) return false;
+
+  SignedMantissaType sum = withSign(lhs, lhs_sign) + withSign(rhs, rhs_sign);
+  bool sign = sum < 0;
+  MantissaType mantissa = magnitude(sum);
+  if (internal::overflow(mantissa)) return false;
+
+  int scale = std::max(lhs_scale, rhs_scale);
+  internal::normalize(mantissa, scale);
+  Access::setError(result, Decimal::NoErrors);
+  Access::assign(result, mantissa, scale, sign);
+  return true;
+}
+
+// Decimal::round() with the scale known at compile time, so that mantissas
+// within 64 bits are divided by a constant, which compiles to a
+// multiplication.
+template <int kScale>
+void DecimalBatch::roundShared(const Decimal* values, Decimal* out,
+                               size_t size) noexcept {
+  for (size_t i = 0; i < size; ++i) {
+    if constexpr (kScale == 0) {
+      out[i] = values[i];
+    } else {
+      MantissaType mantissa = Access::mantissa(values[i]);
+      int remainder = 0;
+      if (kScale <= kMaxPowerOfTen64 + 1 && (mantissa >> 64) == 0) {
+        constexpr uint64_t kDivisor = static_cast<uint64_t>(
+            kPowersOfTen[std::min(kScale - 1, kMaxPowerOfTen64)]);
+        uint64_t head = static_cast<uint64_t>(mantissa) / kDivisor;
+        uint64_t quotient = head / 10;
+        remainder = static_cast<int>(head - quotient * 10);
+        mantissa = quotient;
+      } else {
+        remainder = internal::dropDigits(mantissa, kScale);
+      }
+      internal::round_tail(mantissa, remainder, false);
+      // set in place: a copy through a local would stall on store
+      // forwarding
+      out[i] = values[i];
+      Access::assign(out[i], mantissa, 0, Access::sign(values[i]));
+    }
+  }
+}
+
+}  // namespace s21
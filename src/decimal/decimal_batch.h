@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "decimal.h"
+
+namespace s21 {
+
+// Element-wise operations over arrays of Decimal, for instance a price
+// column times a quantity column. Every function takes size values from each
+// array operand, or one value broadcast to all elements, and writes size
+// results to out, which may be one of the inputs. Results are exactly those
+// of the scalar operators.
+//
+// Arithmetic writes the error code of every result to errors, unless it is
+// null, and returns the number of results with an error.
+//
+// Sums, differences and products that need no rounding are computed as
+// plain 128-bit integer operations; anything else falls back to the scalar
+// operator. Operands of equal scale, the common case within a column, skip
+// the alignment, otherwise it is one multiplication by a power of ten. So do
+// fused multiply-adds whose product and sum need no rounding.
+// Signs are applied without branches, so a column of mixed signs costs no
+// mispredictions. Rounding divides by a compile-time constant for each
+// block of 256 values that share their scale.
+class DecimalBatch {
+ public:
+  static size_t add(const Decimal* lhs, const Decimal* rhs, Decimal* out,
+                    size_t size, uint8_t* errors = nullptr) noexcept;
+  static size_t add(const Decimal* lhs, const Decimal& rhs, Decimal* out,
+                    size_t size, uint8_t* errors = nullptr) noexcept;
+  static size_t sub(const Decimal* lhs, const Decimal* rhs, Decimal* out,
+                    size_t size, uint8_t* errors = nullptr) noexcept;
+  static size_t sub(const Decimal* lhs, const Decimal& rhs, Decimal* out,
+                    size_t size, uint8_t* errors = nullptr) noexcept;
+  static size_t mul(const Decimal* lhs, const Decimal* rhs, Decimal* out,
+                    size_t size, uint8_t* errors = nullptr) noexcept;
+  static size_t mul(const Decimal* lhs, const Decimal& rhs, Decimal* out,
+                    size_t size, uint8_t* errors = nullptr) noexcept;
+  // Division has no exact shortcut, the block loop only saves the calls.
+  static size_t div(const Decimal* lhs, const Decimal* rhs, Decimal* out,
+                    size_t size, uint8_t* errors = nullptr) noexcept;
+  static size_t div(const Decimal* lhs, const Decimal& rhs, Decimal* out,
+                    size_t size, uint8_t* errors = nullptr) noexcept;
+
+  // out[i] = Decimal::fma(lhs[i], rhs[i], addend[i]), for instance a price
+  // times a quantity plus a fee.
+  static size_t fma(const Decimal* lhs, const Decimal* rhs,
+                    const Decimal* addend, Decimal* out, size_t size,
+                    uint8_t* errors = nullptr) noexcept;
+  static size_t fma(const Decimal* lhs, const Decimal* rhs,
+                    const Decimal& addend, Decimal* out, size_t size,
+                    uint8_t* errors = nullptr) noexcept;
+
+  // out[i] = lhs[i].compare(rhs[i]), that is -1, 0 or 1.
+  static void compare(const Decimal* lhs, const Decimal* rhs, int8_t* out,
+                      size_t size) noexcept;
+  static void compare(const Decimal* lhs, const Decimal& rhs, int8_t* out,
+                      size_t size) noexcept;
+
+  // out[i] = values[i].toOrderedKey(), and back; fromOrderedKeys returns the
+  // number of results with an error, ConvertationError for invalid keys.
+  static void toOrderedKeys(const Decimal* values, Decimal::OrderedKey* out,
+                            size_t size) noexcept;
+  static size_t fromOrderedKeys(const Decimal::OrderedKey* keys, Decimal* out,
+                                size_t size,
+                                uint8_t* errors = nullptr) noexcept;
+
+  // out[i] = values[i].round(); errors of the inputs are passed through.
+  static size_t round(const Decimal* values, Decimal* out, size_t size,
+                      uint8_t* errors = nullptr) noexcept;
+
+ private:
+  using MantissaType = Decimal::MantissaType;
+
+  enum Operation { Add, Sub, Mul, Div };
+
+  // Either size consecutive values (stride 1) or one value (stride 0).
+  struct Operand {
+    const Decimal* values;
+    size_t stride;
+
+    const Decimal& operator[](size_t index) const noexcept {
+      return values[index * stride];
+    }
+  };
+
+  template <Operation kOp>
+  static size_t apply(Operand lhs, Operand rhs, Decimal* out, size_t size,
+                      uint8_t* errors) noexcept;
+  static size_t fmaAll(Operand lhs, Operand rhs, Operand addend, Decimal* out,
+                       size_t size, uint8_t* errors) noexcept;
+  static void compareAll(Operand lhs, Operand rhs, int8_t* out,
+                         size_t size) noexcept;
+
+  // Scale shared by size values, or -1 if they differ or any of them has an
+  // error.
+  static int sharedScale(const Decimal* values, size_t size) noexcept;
+
+  // The integer paths return false to leave an element to the scalar
+  // operator.
+  static bool addAligned(const Decimal& lhs, const Decimal& rhs, bool negate,
+                         Decimal& result) noexcept;
+  static bool mulNarrow(const Decimal& lhs, const Decimal& rhs,
+                        Decimal& result) noexcept;
+  static bool fmaNarrow(const Decimal& lhs, const Decimal& rhs,
+                        const Decimal& addend, Decimal& result) noexcept;
+  // The signed sum of two mantissas below 2^96 after alignment.
+  static bool sumAligned(MantissaType lhs, int lhs_scale, bool lhs_sign,
+                         MantissaType rhs, int rhs_scale, bool rhs_sign,
+                         Decimal& result) noexcept;
+
+  using RoundKernel = void (*)(const Decimal*, Decimal*, size_t);
+
+  template <size_t... kScales>
+  static constexpr std::array<RoundKernel, sizeof...(kScales)> roundKernels(
+      std::index_sequence<kScales...>) noexcept;
+  template <int kScale>
+  static void roundShared(const Decimal* values, Decimal* out,
+                          size_t size) noexcept;
+};
+
+}  // namespace s21
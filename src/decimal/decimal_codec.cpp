@@ -0,0 +1,239 @@
+#include "decimal_codec.h"
+
+#include <stdexcept>
+
+namespace s21 {
+
+namespace {
+
+using MantissaType = Decimal::MantissaType;
+using Access = internal::DecimalAccess;
+using SignedMantissaType = Decimal::SignedMantissaType;
+using internal::kMaxScale;
+using internal::kValueBits;
+
+// header byte: the mode in the low 2 bits, the stream scale above them
+constexpr int kModeBits = 2;
+constexpr int kModeMask = (1 << kModeBits) - 1;
+
+// plain form: mantissa << 6 | sign << 5 | scale, or the error code in place
+// of the mantissa with a scale of kErrorScale
+constexpr int kPlainShift = 6;
+constexpr int kSignBit = 5;
+constexpr int kScaleMask = (1 << kSignBit) - 1;
+constexpr int kErrorScale = kScaleMask;
+constexpr int kMaxError = Decimal::ScaleError;
+
+constexpr MantissaType kValueLimit = MantissaType{1} << kValueBits;
+// no valid value has more bits: the plain form plus a flag bit
+constexpr int kMaxWordBits = kValueBits + kPlainShift + 1;
+constexpr int kMaxVarintBits = 7 * DecimalEncoder::kMaxValueSize;
+
+constexpr MantissaType zigzag(SignedMantissaType value) noexcept {
+  return static_cast<MantissaType>(value) << 1 ^
+         static_cast<MantissaType>(value >> 127);
+}
+
+constexpr SignedMantissaType unzigzag(MantissaType word) noexcept {
+  return static_cast<SignedMantissaType>(word >> 1 ^ (0 - (word & 1)));
+}
+
+// Bytes whose 7-bit groups fill 63 bits, as far as most values go; longer
+// varints continue in a second 64-bit word.
+constexpr int kNarrowBytes = 9;
+constexpr int kNarrowBits = 7 * kNarrowBytes;
+
+uint8_t* writeNarrow(uint64_t word, uint8_t* out) noexcept {
+  while (word >= 0x80) {
+    *out++ = static_cast<uint8_t>(word | 0x80);
+    word >>= 7;
+  }
+  *out++ = static_cast<uint8_t>(word);
+  return out;
+}
+
+uint8_t* writeVarint(MantissaType word, uint8_t* out) noexcept {
+  if (word >> kNarrowBits == 0) {
+    return writeNarrow(static_cast<uint64_t>(word), out);
+  }
+  uint64_t low = static_cast<uint64_t>(word);
+  for (int i = 0; i < kNarrowBytes; ++i, low >>= 7) {
+    *out++ = static_cast<uint8_t>(low | 0x80);
+  }
+  return writeNarrow(static_cast<uint64_t>(word >> kNarrowBits), out);
+}
+
+// False for a varint cut off by last or longer than kMaxValueSize bytes.
+bool readVarint(const uint8_t*& ptr, const uint8_t* last,
+                MantissaType& word) noexcept {
+  uint64_t low = 0;
+  int shift = 0;
+  for (; shift < kNarrowBits && ptr != last; shift += 7) {
+    uint8_t byte = *ptr++;
+    low |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (byte < 0x80) {
+      word = low;
+      return true;
+    }
+  }
+  uint64_t high = 0;
+  for (shift = 0; shift < kMaxVarintBits - kNarrowBits && ptr != last;
+       shift += 7) {
+    uint8_t byte = *ptr++;
+    high |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (byte < 0x80) {
+      word = static_cast<MantissaType>(high) << kNarrowBits | low;
+      return true;
+    }
+  }
+  return false;
+}
+
+MantissaType plainWord(MantissaType mantissa, int scale, bool sign,
+                       int error) noexcept {
+  if (error) {
+    return static_cast<MantissaType>(error) << kPlainShift | kErrorScale;
+  }
+  return mantissa << kPlainShift | static_cast<MantissaType>(sign) << kSignBit |
+         static_cast<MantissaType>(scale);
+}
+
+}  // namespace
+
+DecimalEncoder::DecimalEncoder(Mode mode, int scale)
+    : mode_(mode), scale_(mode == Plain ? 0 : scale) {
+  if (static_cast<unsigned>(mode) > Delta) {
+    throw std::invalid_argument("DecimalEncoder mode is unknown");
+  }
+  if (scale < 0 || scale > kMaxScale) {
+    throw std::invalid_argument("DecimalEncoder scale is out of range");
+  }
+  bytes_.push_back(static_cast<uint8_t>(mode_ | scale_ << kModeBits));
+}
+
+void DecimalEncoder::push_back(const Decimal& value) {
+  uint8_t buffer[kMaxValueSize];
+  bytes_.insert(bytes_.end(), buffer, encode(value, buffer));
+}
+
+void DecimalEncoder::append(const Decimal* values, size_t size) {
+  size_t used = bytes_.size();
+  bytes_.resize(used + size * kMaxValueSize);
+  uint8_t* out = bytes_.data() + used;
+  for (size_t i = 0; i < size; ++i) out = encode(values[i], out);
+  bytes_.resize(out - bytes_.data());
+}
+
+std::vector<uint8_t> DecimalEncoder::release() noexcept {
+  std::vector<uint8_t> bytes;
+  bytes.swap(bytes_);
+  return bytes;
+}
+
+uint8_t* DecimalEncoder::encode(const Decimal& value, uint8_t* out) noexcept {
+  const int error = value.getErrorCode();
+  const MantissaType mantissa = error ? 0 : Access::mantissa(value);
+  const int scale = Access::scale(value);
+  const bool sign = Access::sign(value);
+  if (mode_ == Plain) {
+    return writeVarint(plainWord(mantissa, scale, sign, error), out);
+  }
+
+  const int raise = scale_ - scale;
+  if (error || (sign && mantissa == 0) || raise < 0 ||
+      mantissa >= internal::kOverflowThresholds[raise]) {
+    return writeVarint(
+        plainWord(mantissa, scale, sign, error) << 1 | 1, out);
+  }
+  const MantissaType raised = mantissa * internal::kPowersOfTen[raise];
+  SignedMantissaType current = static_cast<SignedMantissaType>(raised);
+  if (sign) current = -current;
+  SignedMantissaType word = current;
+  if (mode_ == Delta) {
+    word -= previous_;
+    previous_ = current;
+  }
+  return writeVarint(zigzag(word) << 1, out);
+}
+
+DecimalDecoder::DecimalDecoder(const uint8_t* first,
+                               const uint8_t* last) noexcept
+    : ptr_(first), last_(last) {
+  if (ptr_ == last_) {
+    failed_ = true;
+    return;
+  }
+  const int mode = *ptr_ & kModeMask;
+  const int scale = *ptr_ >> kModeBits;
+  if (mode > DecimalEncoder::Delta || scale > kMaxScale ||
+      (mode == DecimalEncoder::Plain && scale != 0)) {
+    failed_ = true;
+    return;
+  }
+  mode_ = static_cast<Mode>(mode);
+  scale_ = scale;
+  ++ptr_;
+}
+
+bool DecimalDecoder::next(Decimal& value) noexcept {
+  return decode(&value, 1) == 1;
+}
+
+size_t DecimalDecoder::decode(Decimal* out, size_t capacity) noexcept {
+  if (failed_) return 0;
+  size_t count = 0;
+  for (; count < capacity && ptr_ != last_; ++count) {
+    const uint8_t* start = ptr_;
+    if (!decodeValue(out[count])) {
+      ptr_ = start;
+      failed_ = true;
+      break;
+    }
+  }
+  return count;
+}
+
+bool DecimalDecoder::decodeValue(Decimal& value) noexcept {
+  MantissaType word;
+  if (!readVarint(ptr_, last_, word) || word >> kMaxWordBits != 0) {
+    return false;
+  }
+  if (mode_ != DecimalEncoder::Plain) {
+    const bool escaped = word & 1;
+    word >>= 1;
+    if (!escaped) {
+      SignedMantissaType current = unzigzag(word);
+      if (mode_ == DecimalEncoder::Delta) current += previous_;
+      const bool sign = current < 0;
+      MantissaType mantissa = static_cast<MantissaType>(sign ? -current
+                                                             : current);
+      if (mantissa >= kValueLimit) return false;
+      previous_ = current;
+      int scale = scale_;
+      internal::normalize(mantissa, scale);
+      value = Decimal();
+      Access::assign(value, mantissa, scale, sign && mantissa != 0);
+      return true;
+    }
+  }
+
+  const int scale = static_cast<int>(word) & kScaleMask;
+  const MantissaType mantissa = word >> kPlainShift;
+  if (scale == kErrorScale) {
+    if (mantissa == 0 || mantissa > kMaxError || (word >> kSignBit & 1)) {
+      return false;
+    }
+    value = Decimal();
+    Access::setError(value, static_cast<int>(mantissa));
+    return true;
+  }
+  if (scale > kMaxScale || mantissa >= kValueLimit) return false;
+  MantissaType normalized = mantissa;
+  int normalized_scale = scale;
+  internal::normalize(normalized, normalized_scale);
+  value = Decimal();
+  Access::assign(value, normalized, normalized_scale, word >> kSignBit & 1);
+  return true;
+}
+
+}  // namespace s21
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "decimal.h"
+
+namespace s21 {
+
+// Variable-length binary format for sequences of Decimal, for archives and
+// wire transfer where 16 bytes per value are mostly padding. A stream starts
+// with one header byte, the mode and the stream scale, followed by one
+// LEB128 varint per value, 7 bits per byte with the top bit set on all but
+// the last one:
+//
+// - Plain: the mantissa, then the sign bit and the scale in the low 6 bits.
+//   12.34 takes 3 bytes, an amount of 8 digits 5 and the largest mantissa
+//   15.
+// - CommonScale: the mantissa raised to the stream scale, zigzag-encoded
+//   with the sign in the lowest bit, then a flag bit. Prices of one
+//   instrument share a scale, so no value pays for its own.
+// - Delta: as CommonScale, with the difference from the previous value of
+//   the stream scale instead of the value itself, for sorted columns and
+//   time series, where neighbours are close.
+//
+// A value that does not fit the stream scale (more fractional digits, or
+// too large once raised), -0 and a value with an error are written in the
+// plain form behind a set flag bit, and do not change the previous value of
+// Delta. An error keeps only its code. Decoded values are normalized and
+// equal the encoded ones, -0 included.
+class DecimalEncoder {
+ public:
+  enum Mode { Plain, CommonScale, Delta };
+
+  // longest encoding of one value
+  static constexpr size_t kMaxValueSize = 15;
+
+  // The scale is that of CommonScale and Delta, unused by Plain. Throws
+  // std::invalid_argument for a scale outside 0..28 or an unknown mode.
+  explicit DecimalEncoder(Mode mode = Plain, int scale = 0);
+
+  void push_back(const Decimal& value);
+  void append(const Decimal* values, size_t size);
+
+  // The stream so far, header included.
+  const uint8_t* data() const noexcept { return bytes_.data(); }
+  size_t size() const noexcept { return bytes_.size(); }
+  // Hands over the bytes encoded so far. Later values go to an empty buffer
+  // and continue the same stream, so the released pieces concatenate to it.
+  std::vector<uint8_t> release() noexcept;
+
+  Mode mode() const noexcept { return mode_; }
+  int scale() const noexcept { return scale_; }
+
+ private:
+  using MantissaType = Decimal::MantissaType;
+  using SignedMantissaType = Decimal::SignedMantissaType;
+
+  std::vector<uint8_t> bytes_;
+  Mode mode_;
+  int scale_;
+  SignedMantissaType previous_ = 0;
+
+  // Writes value at out, at most kMaxValueSize bytes; returns the end.
+  uint8_t* encode(const Decimal& value, uint8_t* out) noexcept;
+};
+
+// Reads a stream written by DecimalEncoder straight from memory, without
+// copying it; the buffer must outlive the decoder. Decoding stops at the end
+// of the buffer or at the first malformed value, a truncated or overlong
+// varint or a mantissa, scale or error code out of range; failed() tells
+// the two apart. A buffer without a valid header fails at once.
+class DecimalDecoder {
+ public:
+  using Mode = DecimalEncoder::Mode;
+
+  DecimalDecoder(const uint8_t* first, const uint8_t* last) noexcept;
+  DecimalDecoder(const uint8_t* data, size_t size) noexcept
+      : DecimalDecoder(data, data + size) {}
+
+  // False at the end of the stream or at a malformed value.
+  bool next(Decimal& value) noexcept;
+  // Decodes up to capacity values into out, returns how many.
+  size_t decode(Decimal* out, size_t capacity) noexcept;
+
+  // The first byte not decoded.
+  const uint8_t* position() const noexcept { return ptr_; }
+  bool done() const noexcept { return ptr_ == last_; }
+  bool failed() const noexcept { return failed_; }
+
+  Mode mode() const noexcept { return mode_; }
+  int scale() const noexcept { return scale_; }
+
+ private:
+  using MantissaType = Decimal::MantissaType;
+  using SignedMantissaType = Decimal::SignedMantissaType;
+
+  const uint8_t* ptr_;
+  const uint8_t* last_;
+  Mode mode_ = DecimalEncoder::Plain;
+  int scale_ = 0;
+  bool failed_ = false;
+  SignedMantissaType previous_ = 0;
+
+  // Reads one value at ptr_, false if it is malformed.
+  bool decodeValue(Decimal& value) noexcept;
+};
+
+}  // namespace s21
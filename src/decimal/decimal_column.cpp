@@ -0,0 +1,216 @@
+#include "decimal_column.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include "decimal_accumulator.h"
+
+namespace s21 {
+
+namespace {
+
+using internal::kMaxScale;
+using internal::kOverflowThresholds;
+using internal::kPowersOfTen;
+using internal::withSign;
+using MantissaType = Decimal::MantissaType;
+using Access = internal::DecimalAccess;
+using SignedMantissaType = Decimal::SignedMantissaType;
+
+}  // namespace
+
+DecimalColumn::DecimalColumn(int scale) : initial_scale_(scale) {
+  if (scale < 0 || scale > kMaxScale) {
+    throw std::invalid_argument("Scale must be within 0..28");
+  }
+  scale_ = scale;
+}
+
+void DecimalColumn::reserve(size_t capacity) {
+  low_.reserve(capacity);
+  high_.reserve(capacity);
+  signs_.reserve((capacity + 63) / 64);
+  if (!shared_) scales_.reserve(capacity);
+  if (!errors_.empty()) errors_.reserve(capacity);
+}
+
+void DecimalColumn::clear() noexcept {
+  low_.clear();
+  high_.clear();
+  signs_.clear();
+  scales_.clear();
+  errors_.clear();
+  size_ = 0;
+  failed_ = 0;
+  scale_ = initial_scale_;
+  shared_ = true;
+}
+
+void DecimalColumn::push_back(const Decimal& value) {
+  low_.push_back(0);
+  high_.push_back(0);
+  if (size_ % 64 == 0) signs_.push_back(0);
+  if (!shared_) scales_.push_back(0);
+  if (!errors_.empty()) errors_.push_back(0);
+  store(size_++, value);
+}
+
+Decimal DecimalColumn::get(size_t index) const noexcept {
+  Decimal result;
+  if (int code = error(index)) {
+    Access::assign(result, 0, 0, sign(index));
+    Access::setError(result, code);
+    return result;
+  }
+  MantissaType value = mantissa(index);
+  int value_scale = scale(index);
+  internal::normalize(value, value_scale);
+  Access::assign(result, value, value_scale, sign(index));
+  return result;
+}
+
+void DecimalColumn::set(size_t index, const Decimal& value) {
+  store(index, value);
+}
+
+void DecimalColumn::store(size_t index, const Decimal& value) {
+  setError(index, value.getErrorCode());
+  uint64_t bit = uint64_t{1} << (index % 64);
+  signs_[index / 64] = Access::sign(value) ? signs_[index / 64] | bit
+                                            : signs_[index / 64] & ~bit;
+  // the old value must not keep the column from rescaling
+  low_[index] = 0;
+  high_[index] = 0;
+
+  MantissaType value_mantissa =
+      value.getErrorCode() ? 0 : Access::mantissa(value);
+  int value_scale = value.getErrorCode() ? 0 : Access::scale(value);
+  if (shared_ && value_scale > scale_ && !raiseShared(value_scale)) unshare();
+  if (shared_) {
+    int digits = scale_ - value_scale;
+    if (value_mantissa < kOverflowThresholds[digits]) {
+      value_mantissa *= kPowersOfTen[digits];
+      value_scale = scale_;
+    } else {
+      unshare();
+    }
+  }
+  if (!shared_) scales_[index] = static_cast<uint8_t>(value_scale);
+
+  low_[index] = static_cast<uint64_t>(value_mantissa);
+  high_[index] = static_cast<uint32_t>(value_mantissa >> 64);
+}
+
+void DecimalColumn::setError(size_t index, int error) {
+  if (errors_.empty()) {
+    if (error == 0) return;
+    errors_.resize(size_);
+  }
+  failed_ -= errors_[index] != 0;
+  failed_ += error != 0;
+  errors_[index] = static_cast<uint8_t>(error);
+}
+
+bool DecimalColumn::raiseShared(int scale) noexcept {
+  int digits = scale - scale_;
+  for (size_t i = 0; i < size_; ++i) {
+    if (mantissa(i) >= kOverflowThresholds[digits]) return false;
+  }
+  for (size_t i = 0; i < size_; ++i) {
+    MantissaType value = mantissa(i) * kPowersOfTen[digits];
+    low_[i] = static_cast<uint64_t>(value);
+    high_[i] = static_cast<uint32_t>(value >> 64);
+  }
+  scale_ = scale;
+  return true;
+}
+
+void DecimalColumn::unshare() {
+  scales_.assign(size_, static_cast<uint8_t>(scale_));
+  shared_ = false;
+}
+
+size_t DecimalColumn::firstError() const noexcept {
+  return std::find_if(errors_.begin(), errors_.end(),
+                      [](uint8_t code) { return code != 0; }) -
+         errors_.begin();
+}
+
+Decimal DecimalColumn::sum() const noexcept {
+  if (failed_) return get(firstError());
+
+  // partial sums of up to kSumChunk values fit 128 bits
+  DecimalAccumulator total;
+  for (size_t first = 0; first < size_; first += kSumChunk) {
+    size_t last = std::min(size_, first + kSumChunk);
+    if (shared_) {
+      total.addWide(sumShared(first, last), scale_);
+    } else {
+      SignedMantissaType sums[kMaxScale + 1] = {};
+      for (size_t i = first; i < last; ++i) {
+        sums[scales_[i]] += withSign(mantissa(i), sign(i));
+      }
+      for (int scale = 0; scale <= kMaxScale; ++scale) {
+        total.addWide(sums[scale], scale);
+      }
+    }
+  }
+  return total.result();
+}
+
+Decimal DecimalColumn::min() const noexcept { return select(std::less<>()); }
+
+Decimal DecimalColumn::max() const noexcept {
+  return select(std::greater<>());
+}
+
+Decimal DecimalColumn::mean() const noexcept {
+  Decimal total = sum();
+  if (total.getErrorCode()) return total;
+  return total / Decimal(static_cast<long>(size_));
+}
+
+DecimalColumn::SignedMantissaType DecimalColumn::sumShared(
+    size_t first, size_t last) const noexcept {
+  // the signs are taken a word of 64 at a time and applied with masks
+  SignedMantissaType sum = 0;
+  for (size_t word = first / 64; word * 64 < last; ++word) {
+    uint64_t bits = signs_[word];
+    size_t end = std::min(last, word * 64 + 64);
+    for (size_t i = word * 64; i < end; ++i, bits >>= 1) {
+      sum += withSign(mantissa(i), bits & 1);
+    }
+  }
+  return sum;
+}
+
+template <typename Better>
+Decimal DecimalColumn::select(Better better) const noexcept {
+  if (failed_) return get(firstError());
+  if (size_ == 0) return Decimal();
+
+  size_t best = 0;
+  if (shared_) {
+    SignedMantissaType best_value = withSign(mantissa(0), sign(0));
+    for (size_t i = 1; i < size_; ++i) {
+      SignedMantissaType value = withSign(mantissa(i), sign(i));
+      if (better(value, best_value)) {
+        best_value = value;
+        best = i;
+      }
+    }
+  } else {
+    Decimal best_value = get(0);
+    for (size_t i = 1; i < size_; ++i) {
+      Decimal value = get(i);
+      if (better(value.compare(best_value), 0)) {
+        best_value = value;
+        best = i;
+      }
+    }
+  }
+  return get(best);
+}
+
+}  // namespace s21
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "decimal.h"
+#include "index_iterator.h"
+
+namespace s21 {
+
+// Column of Decimal values stored as separate arrays: the low 64 and the high
+// 32 bits of every mantissa, one sign bit per value and the scales. Scans
+// such as a sum or a maximum read 12 bytes per value instead of a whole
+// Decimal.
+//
+// As long as every value fits 96 bits at the largest scale seen so far, the
+// mantissas are kept at that one scale and no scale array exists. A value
+// that does not fit switches the column to a scale per value for good.
+//
+// A value with an error keeps its error code and sign, its mantissa reads
+// back as zero.
+class DecimalColumn {
+ public:
+  using MantissaType = Decimal::MantissaType;
+
+  // Element proxy: converts to Decimal and assigns through set().
+  class Reference {
+   public:
+    operator Decimal() const noexcept { return column_->get(index_); }
+    Reference& operator=(const Decimal& value) {
+      column_->set(index_, value);
+      return *this;
+    }
+    Reference& operator=(const Reference& other) {
+      return *this = static_cast<Decimal>(other);
+    }
+
+   private:
+    friend class DecimalColumn;
+
+    Reference(DecimalColumn* column, size_t index) noexcept
+        : column_(column), index_(index) {}
+
+    DecimalColumn* column_;
+    size_t index_;
+  };
+
+  using iterator = IndexIterator<DecimalColumn, Reference>;
+  using const_iterator = IndexIterator<const DecimalColumn, Decimal>;
+
+  DecimalColumn() = default;
+  // A column whose mantissas start at scale, so that values with up to
+  // scale fractional digits never rescale the column. Throws
+  // std::invalid_argument for a scale outside 0..28.
+  explicit DecimalColumn(int scale);
+
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  void reserve(size_t capacity);
+  // Removes all values and returns to the scale given to the constructor.
+  void clear() noexcept;
+
+  void push_back(const Decimal& value);
+  Decimal get(size_t index) const noexcept;
+  void set(size_t index, const Decimal& value);
+
+  Decimal operator[](size_t index) const noexcept { return get(index); }
+  Reference operator[](size_t index) noexcept { return {this, index}; }
+
+  iterator begin() noexcept;
+  iterator end() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cbegin() const noexcept;
+  const_iterator cend() const noexcept;
+
+  // The scale of all mantissas, or -1 once every value has its own.
+  int sharedScale() const noexcept { return shared_ ? scale_ : -1; }
+
+  // The raw arrays: size() words each, the sign of value i in bit i % 64 of
+  // word i / 64, and null scales while sharedScale() is not -1.
+  const uint64_t* lowWords() const noexcept { return low_.data(); }
+  const uint32_t* highWords() const noexcept { return high_.data(); }
+  const uint64_t* signBits() const noexcept { return signs_.data(); }
+  const uint8_t* scales() const noexcept {
+    return shared_ ? nullptr : scales_.data();
+  }
+
+  // Reductions over the columnar arrays. The first value with an error, if
+  // any, is returned as the result. The sum is exact and rounded once, half
+  // to even, to fit 96 bits; an overflow is reported like one of operator+.
+  // An empty column has a sum, minimum and maximum of zero and a mean with
+  // DivisionByZeroError.
+  Decimal sum() const noexcept;
+  Decimal min() const noexcept;
+  Decimal max() const noexcept;
+  Decimal mean() const noexcept;
+
+ private:
+  using SignedMantissaType = Decimal::SignedMantissaType;
+
+  // Values summed into one 128-bit partial sum without overflow.
+  static constexpr size_t kSumChunk = size_t{1} << 30;
+
+  std::vector<uint64_t> low_;
+  std::vector<uint32_t> high_;
+  std::vector<uint64_t> signs_;
+  std::vector<uint8_t> scales_;
+  // error codes, allocated by the first value with an error
+  std::vector<uint8_t> errors_;
+  size_t size_ = 0;
+  size_t failed_ = 0;
+  int initial_scale_ = 0;
+  int scale_ = 0;
+  bool shared_ = true;
+
+  MantissaType mantissa(size_t index) const noexcept {
+    return static_cast<MantissaType>(high_[index]) << 64 | low_[index];
+  }
+  bool sign(size_t index) const noexcept {
+    return signs_[index / 64] >> (index % 64) & 1;
+  }
+  int scale(size_t index) const noexcept {
+    return shared_ ? scale_ : scales_[index];
+  }
+  int error(size_t index) const noexcept {
+    return errors_.empty() ? 0 : errors_[index];
+  }
+
+  void store(size_t index, const Decimal& value);
+  void setError(size_t index, int error);
+  // Raises every mantissa to scale, false if one of them would not fit.
+  bool raiseShared(int scale) noexcept;
+  void unshare();
+
+  size_t firstError() const noexcept;
+  SignedMantissaType sumShared(size_t first, size_t last) const noexcept;
+  template <typename Better>
+  Decimal select(Better better) const noexcept;
+};
+
+inline DecimalColumn::iterator DecimalColumn::begin() noexcept {
+  return {this, 0};
+}
+inline DecimalColumn::iterator DecimalColumn::end() noexcept {
+  return {this, size_};
+}
+inline DecimalColumn::const_iterator DecimalColumn::begin() const noexcept {
+  return {this, 0};
+}
+inline DecimalColumn::const_iterator DecimalColumn::end() const noexcept {
+  return {this, size_};
+}
+inline DecimalColumn::const_iterator DecimalColumn::cbegin() const noexcept {
+  return begin();
+}
+inline DecimalColumn::const_iterator DecimalColumn::cend() const noexcept {
+  return end();
+}
+
+}  // namespace s21
@@ -0,0 +1,225 @@
+#include "decimal_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace s21 {
+
+namespace {
+
+using MantissaType = Decimal::MantissaType;
+using Access = internal::DecimalAccess;
+using internal::kMaxScale;
+
+// header: the magic, the format version and the value size as 32-bit words
+// and the number of values as a 64-bit word, zero padded
+constexpr char kMagic[8] = {'S', '2', '1', 'D', 'E', 'C', 'M', 'L'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kVersionOffset = 8;
+constexpr size_t kValueSizeOffset = 12;
+constexpr size_t kCountOffset = 16;
+
+// values converted at a time by write()
+constexpr size_t kWriteChunk = 4096;
+
+// the sign/scale word: sign bit 31, scale in bits 16..23 and the error code
+// in the reserved bits 0..15; bits 24..30 stay clear
+constexpr uint32_t kReservedBits = 0x7F000000;
+
+[[noreturn]] void throwErrno(const std::string& path) {
+  throw std::system_error(errno, std::generic_category(),
+                          "DecimalFile " + path);
+}
+
+// Removes the unfinished file temp written for path, then throws as
+// throwErrno(path).
+[[noreturn]] void discard(const std::string& temp, const std::string& path) {
+  const int error = errno;
+  ::unlink(temp.c_str());
+  errno = error;
+  throwErrno(path);
+}
+
+template <typename Word>
+Word load(const uint8_t* ptr) noexcept {
+  Word word;
+  std::memcpy(&word, ptr, sizeof(word));
+  return word;
+}
+
+template <typename Word>
+void store(uint8_t* ptr, Word word) noexcept {
+  std::memcpy(ptr, &word, sizeof(word));
+}
+
+}  // namespace
+
+void DecimalFile::write(const std::string& path, const Decimal* values,
+                        size_t size) {
+  // Readers may have path mapped: truncating it in place would fault their
+  // pages, so the values go to a new file that replaces path when complete.
+  static std::atomic<unsigned> files{0};
+  const std::string temp = path + ".tmp." + std::to_string(::getpid()) + "." +
+                           std::to_string(files++);
+  const int fd =
+      ::open(temp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+  if (fd < 0) throwErrno(path);
+  std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(::fdopen(fd, "wb"),
+                                                        std::fclose);
+  if (!file) {
+    const int error = errno;
+    ::close(fd);
+    errno = error;
+    discard(temp, path);
+  }
+  auto fail = [&]() {
+    const int error = errno;
+    file.reset();
+    errno = error;
+    discard(temp, path);
+  };
+
+  uint8_t header[kHeaderSize] = {};
+  std::memcpy(header, kMagic, sizeof(kMagic));
+  store<uint32_t>(header + kVersionOffset, kVersion);
+  store<uint32_t>(header + kValueSizeOffset, kValueSize);
+  store<uint64_t>(header + kCountOffset, size);
+  if (std::fwrite(header, 1, kHeaderSize, file.get()) != kHeaderSize) fail();
+
+  std::unique_ptr<uint8_t[]> buffer(new uint8_t[kWriteChunk * kValueSize]);
+  for (size_t first = 0; first < size; first += kWriteChunk) {
+    const size_t count = std::min(kWriteChunk, size - first);
+    for (size_t i = 0; i < count; ++i) {
+      const Decimal& value = values[first + i];
+      const int error = value.getErrorCode();
+      const MantissaType mantissa = error ? 0 : Access::mantissa(value);
+      uint32_t word = static_cast<uint32_t>(error);
+      if (!error) {
+        word |= static_cast<uint32_t>(Access::scale(value)) << 16 |
+                static_cast<uint32_t>(Access::sign(value)) << 31;
+      }
+      uint8_t* out = buffer.get() + i * kValueSize;
+      store<uint64_t>(out, static_cast<uint64_t>(mantissa));
+      store<uint64_t>(out + 8, static_cast<uint64_t>(mantissa >> 64) |
+                                   static_cast<uint64_t>(word) << 32);
+    }
+    if (std::fwrite(buffer.get(), kValueSize, count, file.get()) != count) {
+      fail();
+    }
+  }
+  // the data reaches the disk before the name does
+  if (std::fflush(file.get()) != 0 || ::fsync(fd) != 0) fail();
+  if (std::fclose(file.release()) != 0 ||
+      ::rename(temp.c_str(), path.c_str()) != 0) {
+    discard(temp, path);
+  }
+}
+
+DecimalFile::DecimalFile(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) throwErrno(path);
+  struct stat status;
+  if (::fstat(fd, &status) != 0) {
+    const int error = errno;
+    ::close(fd);
+    errno = error;
+    throwErrno(path);
+  }
+  const size_t file_size = static_cast<size_t>(status.st_size);
+  if (file_size < kHeaderSize) {
+    ::close(fd);
+    throw std::runtime_error("DecimalFile " + path + " has no header");
+  }
+
+  void* mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+  const int error = errno;
+  // the mapping keeps the file open
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    errno = error;
+    throwErrno(path);
+  }
+  mapping_ = static_cast<const uint8_t*>(mapping);
+  mapping_size_ = file_size;
+
+  const uint64_t count = load<uint64_t>(mapping_ + kCountOffset);
+  if (std::memcmp(mapping_, kMagic, sizeof(kMagic)) != 0 ||
+      load<uint32_t>(mapping_ + kVersionOffset) != kVersion ||
+      load<uint32_t>(mapping_ + kValueSizeOffset) != kValueSize ||
+      count != (file_size - kHeaderSize) / kValueSize ||
+      (file_size - kHeaderSize) % kValueSize != 0) {
+    unmap();
+    throw std::runtime_error("DecimalFile " + path +
+                             " is not a complete Decimal file");
+  }
+  size_ = count;
+}
+
+DecimalFile::DecimalFile(DecimalFile&& other) noexcept
+    : mapping_(std::exchange(other.mapping_, nullptr)),
+      mapping_size_(std::exchange(other.mapping_size_, 0)),
+      size_(std::exchange(other.size_, 0)) {}
+
+DecimalFile& DecimalFile::operator=(DecimalFile&& other) noexcept {
+  if (this != &other) {
+    unmap();
+    mapping_ = std::exchange(other.mapping_, nullptr);
+    mapping_size_ = std::exchange(other.mapping_size_, 0);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+DecimalFile::~DecimalFile() { unmap(); }
+
+Decimal DecimalFile::operator[](size_t index) const noexcept {
+  const uint8_t* ptr = values() + index * kValueSize;
+  const uint64_t low = load<uint64_t>(ptr);
+  const uint64_t high = load<uint64_t>(ptr + 8);
+  const uint32_t word = static_cast<uint32_t>(high >> 32);
+  const int error = word & 0xFFFF;
+  const int scale = word >> 16 & 0xFF;
+
+  Decimal value;
+  if (error) {
+    Access::setError(value, error <= Decimal::ScaleError
+                                ? error
+                                : Decimal::ConvertationError);
+  } else if (scale > kMaxScale || (word & kReservedBits)) {
+    Access::setError(value, Decimal::ConvertationError);
+  } else {
+    Access::assign(value,
+                   static_cast<MantissaType>(high & 0xFFFFFFFF) << 64 | low,
+                   scale, word >> 31);
+  }
+  return value;
+}
+
+const Decimal* DecimalFile::data() const noexcept {
+  if (!kInPlace || !mapping_) return nullptr;
+  return reinterpret_cast<const Decimal*>(values());
+}
+
+void DecimalFile::unmap() noexcept {
+  if (mapping_) {
+    ::munmap(const_cast<uint8_t*>(mapping_), mapping_size_);
+  }
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+  size_ = 0;
+}
+
+}  // namespace s21
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "decimal.h"
+#include "index_iterator.h"
+
+namespace s21 {
+
+// Read-only memory-mapped file of Decimal values, for columns that are
+// loaded at startup: opening maps the file and checks its header, values
+// are read in place as the pages are touched, and processes mapping the
+// same file share its page cache.
+//
+// The file is a 64-byte header followed by 16 bytes per value, 16-byte
+// aligned: the s21_decimal bits, little-endian, with the error code of a
+// value in the reserved low 16 bits of the sign/scale word. That is the
+// in-memory layout of Decimal built with S21_DECIMAL_COMPACT, and only that
+// build reads values in place: data() exposes the mapped values as they are.
+// The default build has no in-place view: data() is null and operator[] and
+// the iterators unpack every value they return. make test_compact runs the
+// tests in the compact build.
+//
+// Values are trusted as write() stores them. A word with a scale above 28,
+// set reserved bits or an unknown error code reads as ConvertationError.
+class DecimalFile {
+ public:
+  using const_iterator = IndexIterator<const DecimalFile, Decimal>;
+
+  static constexpr size_t kHeaderSize = 64;
+  static constexpr size_t kValueSize = 16;
+  // true if data() is available
+  static constexpr bool kInPlace =
+#if defined(S21_DECIMAL_COMPACT) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+      true;
+#else
+      false;
+#endif
+
+  // Writes size values to path, replacing it: the values go to a file next to
+  // path that is synced and renamed over it, so a DecimalFile that maps the
+  // old file keeps reading it. Throws std::system_error if the file cannot
+  // be written.
+  static void write(const std::string& path, const Decimal* values,
+                    size_t size);
+
+  DecimalFile() noexcept = default;
+  // Maps path. Throws std::system_error if it cannot be opened or mapped
+  // and std::runtime_error if it is not a complete Decimal file.
+  explicit DecimalFile(const std::string& path);
+  DecimalFile(const DecimalFile&) = delete;
+  DecimalFile(DecimalFile&& other) noexcept;
+  DecimalFile& operator=(const DecimalFile&) = delete;
+  DecimalFile& operator=(DecimalFile&& other) noexcept;
+  ~DecimalFile();
+
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  Decimal operator[](size_t index) const noexcept;
+  // The mapped values, null unless kInPlace.
+  const Decimal* data() const noexcept;
+
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+
+ private:
+  // the start of the mapping, the header
+  const uint8_t* mapping_ = nullptr;
+  size_t mapping_size_ = 0;
+  size_t size_ = 0;
+
+  const uint8_t* values() const noexcept { return mapping_ + kHeaderSize; }
+  void unmap() noexcept;
+};
+
+inline DecimalFile::const_iterator DecimalFile::begin() const noexcept {
+  return {this, 0};
+}
+inline DecimalFile::const_iterator DecimalFile::end() const noexcept {
+  return {this, size_};
+}
+
+}  // namespace s21
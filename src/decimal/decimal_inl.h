@@ -0,0 +1,1246 @@
+#pragma once
+
+// Definitions of the constexpr part of Decimal: construction from integers,
+// arithmetic, comparison and parsing, so that literals and constants can be
+// evaluated at compile time. Included at the end of decimal.h.
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+namespace s21 {
+
+namespace internal {
+
+using MantissaType = Decimal::MantissaType;
+using SignedMantissaType = Decimal::SignedMantissaType;
+
+// std::is_constant_evaluated() is C++20, GCC and Clang provide the builtin
+// in C++17 mode too. Keeps library calls out of compile-time evaluation.
+constexpr bool isConstantEvaluated() noexcept {
+  return __builtin_is_constant_evaluated();
+}
+
+// 10^38 is the largest power of ten representable in the mantissa type,
+// 10^19 the largest one that fits a 64-bit divisor.
+inline constexpr int kMaxPowerOfTen = 38;
+inline constexpr int kMaxPowerOfTen64 = 19;
+
+inline constexpr std::array<MantissaType, kMaxPowerOfTen + 1> kPowersOfTen =
+    [] {
+      std::array<MantissaType, kMaxPowerOfTen + 1> table{};
+      table[0] = 1;
+      for (int i = 1; i <= kMaxPowerOfTen; ++i) {
+        table[i] = table[i - 1] * 10;
+      }
+      return table;
+    }();
+
+inline constexpr int kMantissaBits = sizeof(MantissaType) * 8;
+inline constexpr int kValueBits = 96;
+inline constexpr int kMaxScale = 28;
+
+// kOverflowThresholds[i] is the smallest mantissa that no longer fits into
+// 96 bits after multiplication by 10^i.
+inline constexpr std::array<MantissaType, kMaxScale + 2> kOverflowThresholds =
+    [] {
+      std::array<MantissaType, kMaxScale + 2> table{};
+      constexpr MantissaType kLimit = static_cast<MantissaType>(1)
+                                      << kValueBits;
+      for (int i = 0; i <= kMaxScale + 1; ++i) {
+        table[i] = (kLimit + kPowersOfTen[i] - 1) / kPowersOfTen[i];
+      }
+      return table;
+    }();
+
+// The legacy Term merge treats a sum equal to the all-ones value as not
+// fitting, keep the same boundary.
+constexpr bool fitsMantissa(const UInt256& value) noexcept {
+  return value.fitsIn128() && ~value.low128() != 0;
+}
+
+inline constexpr int bitLength(MantissaType value) noexcept {
+  return UInt256(value).bitLength();
+}
+
+// Number of decimal digits of a non-zero value.
+inline constexpr int digitCount(MantissaType value) noexcept {
+  int estimate = bitLength(value) * 1233 >> 12;
+  return estimate + (value >= kPowersOfTen[estimate]);
+}
+
+// Divides value by 10^digits (digits >= 1) and returns the last digit
+// dropped, which is all the rounding helpers look at.
+inline constexpr int dropDigits(MantissaType& value, int digits) noexcept {
+  if (digits > kMaxPowerOfTen + 1) {
+    value = 0;
+    return 0;
+  }
+  MantissaType head = digits > 1 ? value / kPowersOfTen[digits - 1] : value;
+  value = head / 10;
+  return static_cast<int>(head - value * 10);
+}
+
+// Multiplies value by 10^digits; the product must fit 256 bits.
+constexpr void raiseWide(UInt256& value, int digits) noexcept {
+  while (digits > 0) {
+    int step = std::min(digits, kMaxPowerOfTen64);
+    value.multiply(static_cast<uint64_t>(kPowersOfTen[step]));
+    digits -= step;
+  }
+}
+
+// Folds a 128-bit key into 64 bits: a multiplication mixes the high word
+// into the low one and the MurmurHash3 finalizer spreads the bits.
+constexpr uint64_t hashWords(uint64_t low, uint64_t high) noexcept {
+  uint64_t hash = low ^ high * 0x9E3779B97F4A7C15;
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCD;
+  hash ^= hash >> 33;
+  hash *= 0xC4CEB9FE1A85EC53;
+  return hash ^ hash >> 33;
+}
+
+// Smallest power of ten that pushes a non-zero value past 96 bits.
+inline constexpr int digitsToOverflow(MantissaType value) noexcept {
+  int digits = std::max(0, (kValueBits - bitLength(value)) * 30102 / 100000);
+  while (value < kOverflowThresholds[digits]) ++digits;
+  return digits;
+}
+
+// Multiplies value by ten up to target - scale times, stopping at the first
+// product that exceeds 96 bits. at_least_once mirrors a do-while loop.
+constexpr void raiseScale(MantissaType& value, int& scale,
+                          int target, bool at_least_once = false) noexcept {
+  if (value == 0) {
+    scale = target;
+    return;
+  }
+  int digits = std::min(target - scale, digitsToOverflow(value));
+  if (at_least_once) digits = std::max(digits, 1);
+  value *= kPowersOfTen[digits];
+  scale += digits;
+}
+
+// Lower bound for the number of long division steps after which the
+// quotient of dividend / divisor no longer fits into 96 bits: the smallest k
+// with dividend * 10^k >= divisor * 2^96 is at least this estimate.
+inline constexpr int quotientDigitsToOverflow(MantissaType dividend,
+                                       MantissaType divisor) noexcept {
+  return (kValueBits + bitLength(divisor) - bitLength(dividend)) * 1233 >> 12;
+}
+
+// Runs `digits` steps of decimal long division at once: returns
+// quotient * 10^digits + remainder * 10^digits / divisor and leaves the new
+// remainder. More than 38 steps are only taken for a zero quotient, and the
+// caller keeps the result below 2^100, so the product fits 256 bits.
+constexpr MantissaType longDivision(MantissaType quotient,
+                                    MantissaType& remainder,
+                                    MantissaType divisor, int digits) noexcept {
+  UInt256 scaled = UInt256::multiply(
+      remainder, kPowersOfTen[std::min(digits, kMaxPowerOfTen)]);
+  if (digits > kMaxPowerOfTen) {
+    scaled.multiply(
+        static_cast<uint64_t>(kPowersOfTen[digits - kMaxPowerOfTen]));
+    quotient = 0;
+  } else {
+    quotient *= kPowersOfTen[digits];
+  }
+  remainder = scaled.divide(divisor);
+  return quotient + scaled.low128();
+}
+
+// Strips 16, 8, 4, 2 and 1 trailing zeros while the scale allows it. The
+// power of two factor of 10^step filters out most candidates before the
+// remainder.
+template <typename Value>
+constexpr void stripZeros(Value& value, int& scale) noexcept {
+  for (int step = 16; step > 0 && scale > 0; step >>= 1) {
+    if (step > scale) continue;
+    Value low_bits = (static_cast<Value>(1) << step) - 1;
+    Value power = static_cast<Value>(kPowersOfTen[step]);
+    if ((value & low_bits) == 0 && value % power == 0) {
+      value /= power;
+      scale -= step;
+    }
+  }
+}
+
+// True if value does not fit into the 96-bit mantissa of a Decimal.
+constexpr bool overflow(MantissaType value) noexcept {
+  return (value >> kValueBits) != 0;
+}
+
+// Signs within a column are as good as random, so withSign() and magnitude()
+// apply them with masks rather than branches. Both wrap in unsigned
+// arithmetic, so the most negative value has the magnitude 2^127.
+constexpr SignedMantissaType withSign(MantissaType magnitude,
+                                      bool negative) noexcept {
+  MantissaType mask = -static_cast<MantissaType>(negative);
+  return static_cast<SignedMantissaType>((magnitude ^ mask) - mask);
+}
+
+constexpr MantissaType magnitude(SignedMantissaType value) noexcept {
+  MantissaType mask = static_cast<MantissaType>(value >> 127);
+  return (static_cast<MantissaType>(value) ^ mask) - mask;
+}
+
+// Strips the trailing zeros of an unpacked value; zero gets scale 0.
+constexpr void normalize(MantissaType& mantissa, int& scale) noexcept {
+  if (mantissa == 0) {
+    scale = 0;
+  }
+  if (scale == 0 || (mantissa & 1)) return;
+
+  if (mantissa >> 64) {
+    if (mantissa % 10 == 0) stripZeros(mantissa, scale);
+  } else {
+    uint64_t value = static_cast<uint64_t>(mantissa);
+    stripZeros(value, scale);
+    mantissa = value;
+  }
+}
+
+// Rounds value up if remainder, the first digit dropped from it, is 5 or
+// above; with bank_round, which says no non-zero digit followed it, a 5
+// rounds half to even instead.
+constexpr void round_tail(MantissaType& value, int remainder,
+                          bool bank_round = false) noexcept {
+  if (remainder == 5 && bank_round) {
+    if (value % 2 != 0) value++;
+  } else if (remainder > 4) {
+    value++;
+  }
+}
+
+inline constexpr int kChunkDigits = 19;
+
+// Significant digits kept while scanning: any 29-digit number fits into
+// the 128-bit mantissa type, and one more can never fit into 96 bits.
+inline constexpr int kMaxDigits = 29;
+
+// Ordered key layout: the sign bit on top, set for values from zero up, a
+// 7-bit exponent, the digits aligned to kMaxDigits places and, at the
+// bottom, the number of zeros the alignment appended. The exponent of a
+// non-zero value is its digit count minus its scale, -27..29, biased to
+// 1..57; 0 is left to zero and 127 to errors. The zero count only breaks
+// ties between equal digits, that is between equal values, and saves the
+// decoder from searching for trailing zeros.
+inline constexpr int kKeyExponentShift = 120;
+inline constexpr int kKeyDigitsShift = 23;
+inline constexpr int kKeyExponentBias = 28;
+inline constexpr int kKeyMaxExponent = kMaxDigits + kKeyExponentBias;
+inline constexpr int kKeyErrorExponent = 0x7F;
+inline constexpr MantissaType kKeySignBit = static_cast<MantissaType>(1)
+                                            << 127;
+
+// Digits of a decimal number as written, before scale and range checks.
+struct ScanResult {
+  MantissaType mantissa = 0;
+  int scale = 0;
+  bool sign = false;
+  // first digit that did not fit, and whether any non-zero digit follows it
+  int dropped = 0;
+  bool sticky = false;
+  // more than kMaxDigits significant digits before the decimal point
+  bool overflow = false;
+  // zeros at the end of the digits kept in mantissa
+  int trailing_zeros = 0;
+};
+
+// True if all eight bytes of a little-endian word are ASCII digits.
+constexpr bool isEightDigits(uint64_t block) noexcept {
+  return ((block & 0xF0F0F0F0F0F0F0F0) |
+          (((block + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+         0x3333333333333333;
+}
+
+// Value of eight ASCII digits loaded as a little-endian word, combining
+// neighbouring digits, pairs and quads with one multiplication each.
+constexpr uint32_t parseEightDigits(uint64_t block) noexcept {
+  block -= 0x3030303030303030;
+  block = (block * 10 + (block >> 8)) & 0x00FF00FF00FF00FF;
+  block = (block * 100 + (block >> 16)) & 0x0000FFFF0000FFFF;
+  return static_cast<uint32_t>(block * 10000 + (block >> 32));
+}
+
+// Accumulates digit runs into a ScanResult. Digits go into a 64-bit chunk of
+// at most kChunkDigits, which is folded into the 128-bit mantissa only when
+// it is full, and runs of eight digits are converted at once.
+class DigitScanner {
+ public:
+  constexpr explicit DigitScanner(ScanResult& result) noexcept
+      : result_(result) {}
+
+  // Consumes digits from ptr and returns the first position after them.
+  constexpr const char* scan(const char* ptr, const char* last,
+                             bool fraction) noexcept {
+    while (ptr != last) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+      if (!isConstantEvaluated() && significant_ &&
+          significant_ + 8 <= kMaxDigits && last - ptr >= 8) {
+        uint64_t block = 0;
+        std::memcpy(&block, ptr, sizeof(block));
+        if (isEightDigits(block)) {
+          appendEight(parseEightDigits(block), fraction);
+          ptr += 8;
+          continue;
+        }
+      }
+#endif
+      unsigned digit = static_cast<unsigned char>(*ptr) - '0';
+      if (digit > 9) break;
+      append(digit, fraction);
+      ++ptr;
+    }
+    return ptr;
+  }
+
+  constexpr void finish() noexcept { fold(); }
+
+ private:
+  ScanResult& result_;
+  uint64_t chunk_ = 0;
+  int chunk_digits_ = 0;
+  int significant_ = 0;
+  int extra_ = 0;
+
+  constexpr void fold() noexcept {
+    result_.mantissa =
+        result_.mantissa * kPowersOfTen[chunk_digits_] + chunk_;
+    chunk_ = 0;
+    chunk_digits_ = 0;
+  }
+
+  constexpr void append(unsigned digit, bool fraction) noexcept {
+    if (significant_ < kMaxDigits && (significant_ || digit)) {
+      if (chunk_digits_ == kChunkDigits) fold();
+      chunk_ = chunk_ * 10 + digit;
+      ++chunk_digits_;
+      ++significant_;
+      result_.trailing_zeros = digit ? 0 : result_.trailing_zeros + 1;
+    } else if (significant_ && !fraction) {
+      result_.overflow = true;
+      return;
+    } else if (significant_) {
+      if (extra_++ == 0) {
+        result_.dropped = digit;
+      } else {
+        result_.sticky |= digit != 0;
+      }
+      return;
+    }
+    if (fraction) ++result_.scale;
+  }
+
+  constexpr void appendEight(uint32_t value, bool fraction) noexcept {
+    if (chunk_digits_ > kChunkDigits - 8) fold();
+    chunk_ = chunk_ * 100000000 + value;
+    chunk_digits_ += 8;
+    significant_ += 8;
+    if (value == 0) {
+      result_.trailing_zeros += 8;
+    } else {
+      for (result_.trailing_zeros = 0; value % 10 == 0; value /= 10) {
+        ++result_.trailing_zeros;
+      }
+    }
+    if (fraction) result_.scale += 8;
+  }
+};
+
+// Scans [sign] digits [. digits] and returns the end of the match, or
+// nullptr if there is no digit.
+constexpr const char* scanNumber(const char* first, const char* last,
+                                 ScanResult& result) noexcept {
+  const char* ptr = first;
+  if (ptr != last && (*ptr == '-' || *ptr == '+')) {
+    result.sign = *ptr == '-';
+    ++ptr;
+  }
+
+  DigitScanner scanner(result);
+  const char* end = scanner.scan(ptr, last, false);
+  bool any_digit = end != ptr;
+  if (end != last && *end == '.') {
+    ptr = end + 1;
+    end = scanner.scan(ptr, last, true);
+    any_digit |= end != ptr;
+  }
+  scanner.finish();
+
+  return any_digit ? end : nullptr;
+}
+
+// Parses a whole string, as the string constructor and the _d literal do.
+// A throw during constant evaluation makes an invalid literal ill-formed.
+constexpr Decimal parseWhole(std::string_view input) {
+  Decimal result;
+  auto [ptr, ec] = from_chars(input, result);
+  if (ec == std::errc::invalid_argument || ptr != input.data() + input.size()) {
+    throw std::invalid_argument("Invalid character in input string");
+  }
+  return result;
+}
+
+struct LiteralResult {
+  Decimal value;
+  bool valid = false;
+};
+
+// Parses the characters of a numeric literal, skipping digit separators.
+template <char... Chars>
+constexpr LiteralResult parseLiteral() noexcept {
+  constexpr char kChars[] = {Chars...};
+  char text[sizeof...(Chars)] = {};
+  int size = 0;
+  for (char c : kChars) {
+    if (c != '\'') text[size++] = c;
+  }
+
+  LiteralResult result;
+  auto [ptr, ec] = from_chars(text, text + size, result.value);
+  result.valid = ec == std::errc() && ptr == text + size;
+  return result;
+}
+
+// A variable template forces the parse to happen at compile time.
+template <char... Chars>
+inline constexpr LiteralResult kLiteral = parseLiteral<Chars...>();
+
+// The raw fields of a Decimal, for the modules built on it that pack,
+// unpack or compute values without going through the operators: the batch
+// kernels, the containers, the codecs and the parsers.
+class DecimalAccess {
+ public:
+  static constexpr MantissaType mantissa(const Decimal& value) noexcept {
+    return value.mantissa();
+  }
+  static constexpr int scale(const Decimal& value) noexcept {
+    return value.scale();
+  }
+  static constexpr bool sign(const Decimal& value) noexcept {
+    return value.sign();
+  }
+
+  // Stores a normalized mantissa, scale and sign and flags a mantissa above
+  // 96 bits or a scale outside 0..28. An existing error code is kept.
+  static constexpr void assign(Decimal& value, MantissaType mantissa,
+                               int scale, bool sign) noexcept {
+    value.assign(mantissa, scale, sign);
+  }
+  // Stores value * 10^-scale of any width, rounded half to even to 28
+  // fractional digits and 96 bits, or an overflow error.
+  static constexpr void assign(Decimal& value, const UInt256& wide, int scale,
+                               bool sign) noexcept {
+    value.assignWide(wide, scale, sign);
+  }
+  static constexpr void setError(Decimal& value, int error) noexcept {
+    value.setError(error);
+  }
+};
+
+}  // namespace internal
+
+constexpr Decimal::Decimal(const long& value) noexcept : Decimal() {
+  SignedMantissaType mantissa = static_cast<SignedMantissaType>(value);
+  if (mantissa < 0) {
+    mantissa *= -1;
+    setSign(true);
+  }
+  setMantissa(mantissa);
+}
+
+constexpr Decimal::Decimal(std::initializer_list<uint32_t> values)
+    : Decimal() {
+  uint32_t bits[4] = {0, 0, 0, 0};
+  int count = 0;
+  for (uint32_t value : values) {
+    if (count == 4) break;
+    bits[count++] = value;
+  }
+  bool sign = (bits[3] >> 31) & 1;
+  int scale = (bits[3] >> 16) & 0x1F;
+  bits[3] &= ~(0x1F << 16);
+  bits[3] &= ~(1U << 31);
+
+  // stray bits of the sign/scale word end up above the 96-bit mantissa and
+  // are reported as an overflow
+  MantissaType mantissa = 0;
+  for (int i = 3; i >= 0; --i) {
+    mantissa = mantissa << 32 | bits[i];
+  }
+
+  assign(mantissa, scale, sign);
+  normalize();
+}
+
+constexpr int Decimal::compare(const Decimal& other) const noexcept {
+  if (this == &other) return 0;
+
+  MantissaType lhs = mantissa();
+  MantissaType rhs = other.mantissa();
+  if (lhs == 0 && rhs == 0) return 0;
+
+  if (sign() != other.sign()) {
+    return sign() ? -1 : 1;
+  }
+
+  int result = compareMagnitudes(lhs, scale(), rhs, other.scale());
+  return sign() ? -result : result;
+}
+
+constexpr Decimal::OrderedKey Decimal::toOrderedKey() const noexcept {
+  MantissaType word = orderedWord();
+  OrderedKey key{};
+  if (!internal::isConstantEvaluated()) {
+    // two byte-swapped stores instead of sixteen byte stores
+    uint64_t high = __builtin_bswap64(static_cast<uint64_t>(word >> 64));
+    uint64_t low = __builtin_bswap64(static_cast<uint64_t>(word));
+    std::memcpy(key.data(), &high, sizeof(high));
+    std::memcpy(key.data() + sizeof(high), &low, sizeof(low));
+    return key;
+  }
+  for (int i = kOrderedKeySize - 1; i >= 0; --i, word >>= 8) {
+    key[i] = static_cast<uint8_t>(word);
+  }
+  return key;
+}
+
+constexpr Decimal Decimal::fromOrderedKey(const OrderedKey& key) noexcept {
+  MantissaType word = 0;
+  if (!internal::isConstantEvaluated()) {
+    uint64_t high = 0, low = 0;
+    std::memcpy(&high, key.data(), sizeof(high));
+    std::memcpy(&low, key.data() + sizeof(high), sizeof(low));
+    word = static_cast<MantissaType>(__builtin_bswap64(high)) << 64 |
+           __builtin_bswap64(low);
+  } else {
+    for (uint8_t byte : key) word = word << 8 | byte;
+  }
+  return fromOrderedWord(word);
+}
+
+constexpr size_t Decimal::hash() const noexcept {
+  MantissaType mantissa = this->mantissa();
+  int scale = this->scale();
+  // only a value with an error may not be normalized
+  if (error()) internal::normalize(mantissa, scale);
+
+  // the s21_decimal words, with the sign and scale of zero cleared
+  uint64_t word = 0;
+  if (mantissa != 0) {
+    word = static_cast<uint64_t>(sign()) << 31 |
+           static_cast<uint64_t>(static_cast<uint8_t>(scale)) << 16;
+  }
+  return internal::hashWords(
+      static_cast<uint64_t>(mantissa),
+      static_cast<uint64_t>(mantissa >> 64) ^ word << 32);
+}
+
+constexpr Decimal& Decimal::operator+=(const Decimal& other) {
+  calculate(other, 1);
+  return *this;
+}
+
+constexpr Decimal& Decimal::operator-=(const Decimal& other) {
+  calculate(other, -1);
+  return *this;
+}
+
+constexpr Decimal& Decimal::operator*=(const Decimal& other) {
+  if (error()) return *this;
+  if (other.error()) {
+    setError(other.error());
+    return *this;
+  }
+  multiplyValue(other);
+  return *this;
+}
+
+constexpr void Decimal::multiplyValue(const Decimal& other) {
+  bool sign = this->sign() ^ other.sign();
+  int scale = this->scale() + other.scale();
+
+  if (mantissa() > 1 || other.mantissa() > 1) {
+    multiplyWithClamping(other, scale, sign);
+  } else {
+    MantissaType mantissa = this->mantissa() * other.mantissa();
+    compression(mantissa, scale, true);
+    internal::normalize(mantissa, scale);
+    assign(mantissa, scale, sign);
+  }
+}
+
+constexpr Decimal& Decimal::operator/=(const Decimal& other) {
+  if (error()) return *this;
+  if (other.error()) {
+    setError(other.error());
+    return *this;
+  }
+  divideValue(other);
+  return *this;
+}
+
+constexpr void Decimal::divideValue(const Decimal& other) noexcept {
+  if (other.mantissa() == 0) {
+    setError(DivisionByZeroError);
+    return;
+  }
+
+  if (mantissa() == 0) {
+    normalize();
+    return;
+  }
+
+  bool sign = this->sign() ^ other.sign();
+  int scale = this->scale() - other.scale();
+  MantissaType divisor = other.mantissa();
+  MantissaType remainder = mantissa() % divisor;
+  MantissaType result = mantissa() / divisor;
+
+  // The digit loop below stops at the first quotient digit that leaves no
+  // remainder, pushes the quotient past 96 bits or reaches scale 29. The
+  // digits that cannot do the last two are produced by one wide division;
+  // stopping past an exact digit only adds trailing zeros, which normalize
+  // removes again.
+  if (remainder) {
+    int digits =
+        std::min(internal::kMaxScale + 1 - scale,
+                 internal::quotientDigitsToOverflow(mantissa(), divisor));
+    if (digits > 1) {
+      result = internal::longDivision(result, remainder, divisor, digits);
+      scale += digits;
+    }
+  }
+
+  while (remainder && !internal::overflow(result) && scale < 29) {
+    remainder *= 10;
+    result = result * 10 + remainder / divisor;
+    remainder %= divisor;
+    ++scale;
+  }
+
+  if (internal::overflow(result) || scale == 29) {
+    int digit = result % 10;
+    result /= 10;
+    internal::round_tail(result, digit, !remainder);
+    --scale;
+  }
+
+  if (scale < 0) {
+    internal::raiseScale(result, scale, 0, true);
+  }
+
+  internal::normalize(result, scale);
+  assign(result, scale, sign);
+}
+
+constexpr Decimal& Decimal::operator%=(const Decimal& other) {
+  if (error()) return *this;
+  if (other.error()) {
+    setError(other.error());
+    return *this;
+  }
+  if (other.mantissa() == 0) {
+    setError(DivisionByZeroError);
+    return *this;
+  }
+
+  if (scale() || other.scale()) {
+    setError(ScaleError);
+    return *this;
+  }
+
+  if (mantissa() == 0) {
+    normalize();
+    return *this;
+  }
+
+  setSign(sign() ^ other.sign());
+  setMantissa(mantissa() % other.mantissa());
+
+  return *this;
+}
+
+constexpr Decimal Decimal::round() const noexcept {
+  if (!scale()) {
+    return *this;
+  }
+
+  Decimal result = *this;
+  MantissaType mantissa = result.mantissa();
+  int scale = result.scale();
+
+  if (scale > 0) {
+    int remainder = internal::dropDigits(mantissa, scale);
+    internal::round_tail(mantissa, remainder, false);
+    scale = 0;
+  }
+
+  result.setMantissa(mantissa);
+  result.setScale(scale);
+  return result;
+}
+
+constexpr Decimal Decimal::floor() const noexcept {
+  if (!scale()) {
+    return *this;
+  }
+
+  Decimal result = truncate();
+
+  if (result.sign()) {
+    result.setMantissa(result.mantissa() + 1);
+  }
+
+  return result;
+}
+
+constexpr Decimal Decimal::truncate() const noexcept {
+  if (!scale()) {
+    return *this;
+  }
+
+  Decimal result = *this;
+  MantissaType mantissa = result.mantissa();
+  int scale = result.scale();
+  if (scale > 0) {
+    internal::dropDigits(mantissa, scale);
+    scale = 0;
+  }
+
+  result.setMantissa(mantissa);
+  result.setScale(scale);
+  return result;
+}
+
+constexpr Decimal Decimal::negate() const noexcept {
+  Decimal result = *this;
+  result.setSign(!sign());
+
+  return result;
+}
+
+constexpr void Decimal::calculate(const Decimal& other, int8_t factor) {
+  if (error()) return;
+  if (other.error()) {
+    setError(other.error());
+    return;
+  }
+  calculateValue(other, factor);
+}
+
+constexpr void Decimal::calculateValue(const Decimal& other,
+                                       int8_t factor) noexcept {
+  MantissaType lhs = mantissa();
+  MantissaType rhs = other.mantissa();
+  int scale = this->scale();
+  int other_scale = other.scale();
+  alignScales(lhs, scale, rhs, other_scale);
+
+  SignedMantissaType result = static_cast<SignedMantissaType>(lhs);
+  if (sign()) {
+    result *= -1;
+  }
+  SignedMantissaType other_mantissa = static_cast<SignedMantissaType>(rhs);
+  if (other.sign()) {
+    other_mantissa *= -1;
+  }
+  result += other_mantissa * factor;
+
+  bool sign = result < 0;
+  if (sign) {
+    result *= -1;
+  }
+  MantissaType mantissa = result;
+  compression(mantissa, scale, true);
+  internal::normalize(mantissa, scale);
+  assign(mantissa, scale, sign);
+}
+
+constexpr Decimal Decimal::fma(const Decimal& a, const Decimal& b,
+                               const Decimal& c) noexcept {
+  Decimal result = a;
+  if (a.error()) return result;
+  if (b.error() || c.error()) {
+    result.setError(b.error() ? b.error() : c.error());
+    return result;
+  }
+
+  // Product digits beyond the 36th fractional one only survive as a sticky
+  // flag; the result keeps 28 at most.
+  constexpr int kWideScale = 36;
+  UInt256 product = UInt256::multiply(a.mantissa(), b.mantissa());
+  int product_scale = a.scale() + b.scale();
+  bool product_sign = a.sign() != b.sign();
+  bool sticky = false;
+  if (product_scale > kWideScale) {
+    sticky = product.divide(
+                 internal::kPowersOfTen[product_scale - kWideScale]) != 0;
+    product_scale = kWideScale;
+  }
+
+  int scale = std::max(product_scale, c.scale());
+  if (product_scale < scale) {
+    // a product of 2^97 or more overflows whatever the addend is, a smaller
+    // one still fits 256 bits when aligned
+    UInt256 limit =
+        UInt256::multiply(static_cast<MantissaType>(1) << 97,
+                          internal::kPowersOfTen[product_scale]);
+    if (product.compare(limit) >= 0) {
+      result.setSign(product_sign);
+      result.setError(product_sign ? NegativeOverflowError
+                                   : PositiveOverflowError);
+      return result;
+    }
+    internal::raiseWide(product, scale - product_scale);
+  }
+  UInt256 addend(c.mantissa());
+  internal::raiseWide(addend, scale - c.scale());
+
+  bool sign = product_sign;
+  if (product_sign == c.sign()) {
+    product.add(addend);
+  } else if (product.compare(addend) >= 0) {
+    product.subtract(addend);
+  } else {
+    addend.subtract(product);
+    product = addend;
+    sign = c.sign();
+  }
+  if (product.isZero()) sign = false;
+
+  if (sticky) {
+    // The dropped digits lie strictly between two units of the last kept
+    // one. A tenth of a unit in their place rounds the same way, as the
+    // result drops at least nine more digits.
+    product.multiply(10);
+    if (product.isZero()) {
+      product = UInt256(1);
+      sign = product_sign;
+    } else if (sign == product_sign) {
+      product.add(UInt256(1));
+    } else {
+      product.subtract(UInt256(1));
+    }
+    ++scale;
+  }
+
+  result = Decimal();
+  result.assignWide(product, scale, sign);
+  return result;
+}
+
+constexpr Decimal::MantissaType Decimal::orderedWord() const noexcept {
+  using internal::kKeyExponentShift;
+  using internal::kKeySignBit;
+
+  if (error()) {
+    return kKeySignBit |
+           static_cast<MantissaType>(internal::kKeyErrorExponent)
+               << kKeyExponentShift |
+           static_cast<uint16_t>(error());
+  }
+  MantissaType mantissa = this->mantissa();
+  if (mantissa == 0) return kKeySignBit;
+
+  int digits = internal::digitCount(mantissa);
+  int zeros = internal::kMaxDigits - digits;
+  int exponent = digits - scale() + internal::kKeyExponentBias;
+  MantissaType word =
+      kKeySignBit | static_cast<MantissaType>(exponent) << kKeyExponentShift |
+      mantissa * internal::kPowersOfTen[zeros] << internal::kKeyDigitsShift |
+      static_cast<MantissaType>(zeros);
+  // a larger magnitude makes a smaller negative value
+  return sign() ? ~word : word;
+}
+
+constexpr Decimal Decimal::fromOrderedWord(MantissaType word) noexcept {
+  using internal::kKeyDigitsShift;
+  using internal::kKeyExponentShift;
+  using internal::kMaxPowerOfTen64;
+  using internal::kPowersOfTen;
+
+  Decimal result;
+  const MantissaType key = word;
+  bool negative = !(word & internal::kKeySignBit);
+  if (negative) word = ~word;
+  int exponent = static_cast<int>(word >> kKeyExponentShift) & 0x7F;
+  MantissaType low =
+      word & ((static_cast<MantissaType>(1) << kKeyExponentShift) - 1);
+
+  if (!negative && exponent == internal::kKeyErrorExponent && low != 0 &&
+      low <= 0xFFFF) {
+    result.setError(static_cast<int>(low));
+    return result;
+  }
+  if (!negative && exponent == 0 && low == 0) return result;
+
+  // undo the alignment, then accept only the key of the value found
+  int zeros = static_cast<int>(low & ((1 << kKeyDigitsShift) - 1));
+  MantissaType mantissa = low >> kKeyDigitsShift;
+  int scale = internal::kMaxDigits - zeros + internal::kKeyExponentBias -
+              exponent;
+  if (zeros < internal::kMaxDigits && scale >= 0 &&
+      scale <= internal::kMaxScale) {
+    if (zeros > kMaxPowerOfTen64) {
+      mantissa /= static_cast<uint64_t>(kPowersOfTen[kMaxPowerOfTen64]);
+      zeros -= kMaxPowerOfTen64;
+    }
+    mantissa /= static_cast<uint64_t>(kPowersOfTen[zeros]);
+    if (!internal::overflow(mantissa)) {
+      result.assign(mantissa, scale, negative);
+      if (mantissa != 0 && result.orderedWord() == key) return result;
+    }
+  }
+  result = Decimal();
+  result.setError(ConvertationError);
+  return result;
+}
+
+constexpr void Decimal::multiplyWithClamping(const Decimal& other, int scale,
+                                             bool sign) {
+#ifdef S21_DECIMAL_DEBUG_MULTIPLY
+  // the legacy path allocates, so it is only cross-checked at run time
+  const bool cross_check = !internal::isConstantEvaluated();
+  Decimal legacy = *this;
+  if (cross_check) legacy.multiplyWithTerm(other, scale, sign);
+#endif
+
+  UInt256 product = UInt256::multiply(mantissa(), other.mantissa());
+
+  // Drop scale digits until the product fits into the mantissa type. The
+  // dropped digits are truncated, only compression() rounds afterwards.
+  // bitLength() gives a lower bound of the digits still to be dropped, so
+  // most of them go in a single division.
+  bool digits_dropped = false;
+  while (scale && !internal::fitsMantissa(product)) {
+    int digits =
+        (product.bitLength() - internal::kMantissaBits - 1) * 30102 / 100000;
+    digits = std::clamp(digits, 1, std::min(scale, internal::kMaxPowerOfTen64));
+    product.divide(static_cast<uint64_t>(internal::kPowersOfTen[digits]));
+    scale -= digits;
+    digits_dropped = true;
+  }
+
+  if (!internal::fitsMantissa(product)) {
+    setSign(sign);
+    setError(sign ? NegativeOverflowError : PositiveOverflowError);
+  } else {
+    MantissaType mantissa = product.low128();
+    compression(mantissa, scale, !digits_dropped);
+    internal::normalize(mantissa, scale);
+    assign(mantissa, scale, sign);
+  }
+
+#ifdef S21_DECIMAL_DEBUG_MULTIPLY
+  if (cross_check) {
+    assert(legacy.error() == error());
+    assert(error() || (legacy.mantissa() == mantissa() &&
+                       legacy.scale() == this->scale()));
+  }
+#endif
+}
+
+constexpr void Decimal::normalize() noexcept {
+  if (error()) return;
+
+  MantissaType mantissa = this->mantissa();
+  int scale = this->scale();
+  internal::normalize(mantissa, scale);
+  setMantissa(mantissa);
+  setScale(scale);
+}
+
+constexpr void Decimal::assign(MantissaType mantissa, int scale,
+                               bool sign) noexcept {
+  setMantissa(mantissa);
+  setScale(scale);
+  setSign(sign);
+
+  if (internal::overflow(mantissa)) {
+    setError(sign ? NegativeOverflowError : PositiveOverflowError);
+  } else if (scale < 0 || scale > 28) {
+    setError(ScaleError);
+  }
+}
+
+constexpr void Decimal::assignWide(UInt256 value, int scale,
+                                   bool sign) noexcept {
+  using internal::kPowersOfTen;
+  using internal::kValueBits;
+
+  // One division drops the digits beyond the 28th fractional one and as
+  // many as the value needs to fit 96 bits; a second one follows if
+  // rounding up reaches 2^96.
+  int digits = std::max(0, scale - internal::kMaxScale);
+  while (scale > 0 && (digits > 0 || value.bitLength() > kValueBits)) {
+    digits = std::max(
+        {digits, 1,
+         std::min(scale, (value.bitLength() - kValueBits) * 1233 >> 12)});
+    UInt256 quotient = value;
+    MantissaType remainder = quotient.divide(kPowersOfTen[digits]);
+    while (quotient.bitLength() > kValueBits && digits < scale) {
+      quotient = value;
+      remainder = quotient.divide(kPowersOfTen[++digits]);
+    }
+    MantissaType half = kPowersOfTen[digits] / 2;
+    bool up = remainder > half || (remainder == half && (quotient.limb(0) & 1));
+    value = quotient;
+    value.add(UInt256(static_cast<MantissaType>(up)));
+    scale -= digits;
+    digits = 0;
+  }
+
+  if (value.bitLength() > kValueBits) {
+    setSign(sign);
+    setError(sign ? NegativeOverflowError : PositiveOverflowError);
+    return;
+  }
+  MantissaType mantissa = value.low128();
+  internal::normalize(mantissa, scale);
+  assign(mantissa, scale, sign);
+}
+
+constexpr void Decimal::compression(MantissaType& mantissa, int& scale,
+                                    bool bank_round) noexcept {
+  int remainder = 0;
+  int count = 0;
+
+  if (mantissa > 0 && scale > internal::kMaxScale) {
+    int digits = std::min(scale - internal::kMaxScale,
+                          internal::digitCount(mantissa));
+    remainder = internal::dropDigits(mantissa, digits);
+    count += digits;
+    scale -= digits;
+  }
+
+  // a mantissa of h * 2^96 + l needs as many digits dropped as h has
+  if (internal::overflow(mantissa) && scale > 0) {
+    int digits = std::min(
+        scale, internal::digitCount(mantissa >> internal::kValueBits));
+    remainder = internal::dropDigits(mantissa, digits);
+    count += digits;
+    scale -= digits;
+  }
+
+  if (count) {
+    internal::round_tail(mantissa, remainder, count == 1 && bank_round);
+  }
+}
+
+constexpr void Decimal::alignScales(MantissaType& lhs, int& lhs_scale,
+                                    MantissaType& rhs,
+                                    int& rhs_scale) noexcept {
+  if (lhs_scale > rhs_scale) {
+    internal::raiseScale(rhs, rhs_scale, lhs_scale);
+  } else if (lhs_scale < rhs_scale) {
+    internal::raiseScale(lhs, lhs_scale, rhs_scale);
+  }
+
+  // the operand that overflowed first is kept, the other one loses digits;
+  // the rounding is applied to lhs in both cases
+  if (lhs_scale > rhs_scale) {
+    int count = lhs_scale - rhs_scale;
+    int remainder = internal::dropDigits(lhs, count);
+    lhs_scale = rhs_scale;
+    internal::round_tail(lhs, remainder, count == 1);
+  } else if (lhs_scale < rhs_scale) {
+    int count = rhs_scale - lhs_scale;
+    int remainder = internal::dropDigits(rhs, count);
+    rhs_scale = lhs_scale;
+    internal::round_tail(lhs, remainder, count == 1);
+  }
+}
+
+// Exact three-way comparison of lhs * 10^-lhs_scale and rhs * 10^-rhs_scale.
+// The operand with the smaller scale is multiplied by a power of ten into a
+// 256-bit product; bit lengths decide most cases before that.
+constexpr int Decimal::compareMagnitudes(MantissaType lhs, int lhs_scale,
+                                         MantissaType rhs,
+                                         int rhs_scale) noexcept {
+  if (lhs_scale > rhs_scale) {
+    return -compareMagnitudes(rhs, rhs_scale, lhs, lhs_scale);
+  }
+  if (lhs == 0 || rhs == 0 || lhs_scale == rhs_scale) {
+    return (lhs > rhs) - (lhs < rhs);
+  }
+
+  int digits = rhs_scale - lhs_scale;
+  if (digits > internal::kMaxPowerOfTen) return 1;
+
+  // lhs * 10^digits lies in [2^(lhs_bits - 2), 2^lhs_bits)
+  int lhs_bits = internal::bitLength(lhs) +
+                 internal::bitLength(internal::kPowersOfTen[digits]);
+  int rhs_bits = internal::bitLength(rhs);
+  if (lhs_bits > rhs_bits + 1) return 1;
+  if (lhs_bits < rhs_bits) return -1;
+
+  UInt256 product = UInt256::multiply(lhs, internal::kPowersOfTen[digits]);
+  if (!product.fitsIn128()) return 1;
+  MantissaType value = product.low128();
+  return (value > rhs) - (value < rhs);
+}
+
+constexpr std::from_chars_result from_chars(const char* first, const char* last,
+                                            Decimal& value) noexcept {
+  internal::ScanResult digits;
+  const char* ptr = internal::scanNumber(first, last, digits);
+  if (!ptr) {
+    return {first, std::errc::invalid_argument};
+  }
+
+  Decimal::MantissaType mantissa = digits.mantissa;
+  int scale = digits.scale;
+  int dropped = digits.dropped;
+  bool sticky = digits.sticky;
+
+  // beyond 28 fractional digits, or 29 digits above 96 bits, the tail goes
+  // into the rounding digit and the sticky flag
+  int excess = std::max(scale - internal::kMaxScale,
+                        internal::overflow(mantissa) && scale > 0 ? 1 : 0);
+  if (excess > 0) {
+    Decimal::MantissaType tail =
+        excess - 1 > internal::kMaxPowerOfTen
+            ? mantissa
+            : mantissa % internal::kPowersOfTen[excess - 1];
+    sticky |= dropped != 0 || tail != 0;
+    dropped = internal::dropDigits(mantissa, excess);
+    scale -= excess;
+  }
+  bool exact = excess == 0 && dropped < 5;
+  internal::round_tail(mantissa, dropped, !sticky);
+  if (internal::overflow(mantissa) && scale > 0) {
+    Decimal::compression(mantissa, scale);
+  }
+
+  if (digits.overflow || internal::overflow(mantissa)) {
+    Decimal result;
+    result.assign(~static_cast<Decimal::MantissaType>(0), 0, digits.sign);
+    value = result;
+    return {ptr, std::errc::result_out_of_range};
+  }
+
+  if (!exact) {
+    internal::normalize(mantissa, scale);
+  } else if (mantissa == 0) {
+    scale = 0;
+  } else if (int zeros = std::min(digits.trailing_zeros, scale)) {
+    // the digits are kept as written, so the trailing zeros are known
+    mantissa /= internal::kPowersOfTen[zeros];
+    scale -= zeros;
+  }
+  Decimal result;
+  result.assign(mantissa, scale, digits.sign);
+  value = result;
+  return {ptr, std::errc()};
+}
+
+constexpr std::from_chars_result from_chars(std::string_view text,
+                                            Decimal& value) noexcept {
+  return from_chars(text.data(), text.data() + text.size(), value);
+}
+
+constexpr Decimal operator"" _d(const char* str, size_t size) {
+  return internal::parseWhole(std::string_view(str, size));
+}
+
+constexpr Decimal operator+(const Decimal& lhs, const Decimal& rhs) {
+  Decimal result(lhs);
+  result += rhs;
+  return result;
+}
+
+constexpr Decimal operator-(const Decimal& lhs, const Decimal& rhs) {
+  Decimal result(lhs);
+  result -= rhs;
+  return result;
+}
+
+constexpr Decimal operator*(const Decimal& lhs, const Decimal& rhs) {
+  Decimal result(lhs);
+  result *= rhs;
+  return result;
+}
+
+constexpr Decimal operator/(const Decimal& lhs, const Decimal& rhs) {
+  Decimal result(lhs);
+  result /= rhs;
+  return result;
+}
+
+constexpr Decimal operator%(const Decimal& lhs, const Decimal& rhs) {
+  Decimal result(lhs);
+  result %= rhs;
+  return result;
+}
+
+constexpr Decimal operator-(const Decimal& value) noexcept {
+  return value.negate();
+}
+
+namespace unchecked {
+
+constexpr Decimal add(const Decimal& lhs, const Decimal& rhs) {
+  Decimal result(lhs);
+  result.calculateValue(rhs, 1);
+  return result;
+}
+
+constexpr Decimal sub(const Decimal& lhs, const Decimal& rhs) {
+  Decimal result(lhs);
+  result.calculateValue(rhs, -1);
+  return result;
+}
+
+constexpr Decimal mul(const Decimal& lhs, const Decimal& rhs) {
+  Decimal result(lhs);
+  result.multiplyValue(rhs);
+  return result;
+}
+
+constexpr Decimal div(const Decimal& lhs, const Decimal& rhs) {
+  Decimal result(lhs);
+  result.divideValue(rhs);
+  return result;
+}
+
+}  // namespace unchecked
+
+namespace checked {
+
+constexpr bool add(const Decimal& lhs, const Decimal& rhs, Decimal* result) {
+  *result = lhs + rhs;
+  return result->getErrorCode() != Decimal::NoErrors;
+}
+
+constexpr bool sub(const Decimal& lhs, const Decimal& rhs, Decimal* result) {
+  *result = lhs - rhs;
+  return result->getErrorCode() != Decimal::NoErrors;
+}
+
+constexpr bool mul(const Decimal& lhs, const Decimal& rhs, Decimal* result) {
+  *result = lhs * rhs;
+  return result->getErrorCode() != Decimal::NoErrors;
+}
+
+constexpr bool div(const Decimal& lhs, const Decimal& rhs, Decimal* result) {
+  *result = lhs / rhs;
+  return result->getErrorCode() != Decimal::NoErrors;
+}
+
+}  // namespace checked
+
+template <char... Chars>
+constexpr Decimal operator"" _dec() noexcept {
+  static_assert(internal::kLiteral<Chars...>.valid,
+                "_dec expects digits[.digits] with an integer part that fits "
+                "into 96 bits");
+  return internal::kLiteral<Chars...>.value;
+}
+
+}  // namespace s21
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "decimal.h"
+
+namespace s21 {
+
+// Hash map keyed by Decimal, with open addressing and linear probing. Keys
+// are kept in their normalized 16-byte form, the words of s21_decimal, in an
+// array of their own: a probe compares two 64-bit words, four slots share a
+// cache line, and no compare() or scale alignment is involved. Keys that
+// compare equal, such as 0 and -0, are the same key, and the slot of a key
+// is taken from the same hash as std::hash<Decimal>.
+//
+// A key with an error is never found; inserting one throws
+// std::invalid_argument. Value must be default constructible. Inserting may
+// rehash and erasing may move entries, so both invalidate the pointers
+// returned by find().
+template <typename Value>
+class DecimalMap {
+ public:
+  DecimalMap() = default;
+
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  // Makes room for count keys without a rehash.
+  void reserve(size_t count);
+  void clear() noexcept;
+
+  // The value of key, inserted default constructed if it is missing.
+  Value& operator[](const Decimal& key);
+  // Inserts key with value unless key is present; true if it was inserted.
+  bool insert(const Decimal& key, Value value);
+  // The value of key, nullptr if it is missing.
+  Value* find(const Decimal& key) noexcept;
+  const Value* find(const Decimal& key) const noexcept;
+  bool contains(const Decimal& key) const noexcept {
+    return find(key) != nullptr;
+  }
+  // True if key was present.
+  bool erase(const Decimal& key) noexcept;
+
+  // Calls visit(key, value) for every entry, in no particular order.
+  template <typename Visit>
+  void forEach(Visit visit) const;
+  template <typename Visit>
+  void forEach(Visit visit);
+
+ private:
+  using MantissaType = Decimal::MantissaType;
+  using Access = internal::DecimalAccess;
+
+  // the mantissa below 2^96 and the sign/scale word of s21_decimal above it
+  struct Key {
+    uint64_t low;
+    uint64_t high;
+
+    bool operator==(const Key& other) const noexcept {
+      return low == other.low && high == other.high;
+    }
+  };
+
+  // the upper word of an empty slot: no key has a scale of 255
+  static constexpr uint64_t kEmpty = ~uint64_t{0};
+  static constexpr size_t kMinCapacity = 16;
+
+  std::vector<Key> keys_;
+  std::vector<Value> values_;
+  size_t size_ = 0;
+
+  // False for a value with an error.
+  static bool makeKey(const Decimal& value, Key& key) noexcept;
+  static Decimal toDecimal(const Key& key) noexcept;
+
+  size_t home(const Key& key) const noexcept {
+    return internal::hashWords(key.low, key.high) & (keys_.size() - 1);
+  }
+  // The slot holding key, or the empty slot where it belongs.
+  size_t locate(const Key& key) const noexcept;
+  // The slot of a new key, after a rehash if the table would get too full.
+  size_t prepareInsert(const Key& key);
+  void rehash(size_t capacity);
+};
+
+template <typename Value>
+void DecimalMap<Value>::reserve(size_t count) {
+  // at most three quarters of the slots are used
+  size_t capacity = kMinCapacity;
+  while (capacity / 4 * 3 < count) capacity *= 2;
+  if (capacity > keys_.size()) rehash(capacity);
+}
+
+template <typename Value>
+void DecimalMap<Value>::clear() noexcept {
+  keys_.clear();
+  values_.clear();
+  size_ = 0;
+}
+
+template <typename Value>
+Value& DecimalMap<Value>::operator[](const Decimal& key) {
+  Key packed;
+  if (!makeKey(key, packed)) {
+    throw std::invalid_argument("DecimalMap key has an error");
+  }
+  size_t slot = keys_.empty() ? 0 : locate(packed);
+  if (keys_.empty() || keys_[slot].high == kEmpty) {
+    slot = prepareInsert(packed);
+    keys_[slot] = packed;
+    ++size_;
+  }
+  return values_[slot];
+}
+
+template <typename Value>
+bool DecimalMap<Value>::insert(const Decimal& key, Value value) {
+  Key packed;
+  if (!makeKey(key, packed)) {
+    throw std::invalid_argument("DecimalMap key has an error");
+  }
+  if (!keys_.empty() && keys_[locate(packed)].high != kEmpty) return false;
+
+  size_t slot = prepareInsert(packed);
+  keys_[slot] = packed;
+  values_[slot] = std::move(value);
+  ++size_;
+  return true;
+}
+
+template <typename Value>
+Value* DecimalMap<Value>::find(const Decimal& key) noexcept {
+  const auto& map = *this;
+  return const_cast<Value*>(map.find(key));
+}
+
+template <typename Value>
+const Value* DecimalMap<Value>::find(const Decimal& key) const noexcept {
+  Key packed;
+  if (keys_.empty() || !makeKey(key, packed)) return nullptr;
+  size_t slot = locate(packed);
+  return keys_[slot].high == kEmpty ? nullptr : &values_[slot];
+}
+
+template <typename Value>
+bool DecimalMap<Value>::erase(const Decimal& key) noexcept {
+  Key packed;
+  if (keys_.empty() || !makeKey(key, packed)) return false;
+  size_t hole = locate(packed);
+  if (keys_[hole].high == kEmpty) return false;
+
+  // Backward shift: an entry further along the probe sequence moves into the
+  // hole unless its home slot lies after the hole, so no tombstones remain.
+  const size_t mask = keys_.size() - 1;
+  for (size_t next = (hole + 1) & mask; keys_[next].high != kEmpty;
+       next = (next + 1) & mask) {
+    if (((next - home(keys_[next])) & mask) >= ((next - hole) & mask)) {
+      keys_[hole] = keys_[next];
+      values_[hole] = std::move(values_[next]);
+      hole = next;
+    }
+  }
+  keys_[hole].high = kEmpty;
+  values_[hole] = Value();
+  --size_;
+  return true;
+}
+
+template <typename Value>
+template <typename Visit>
+void DecimalMap<Value>::forEach(Visit visit) const {
+  for (size_t slot = 0; slot < keys_.size(); ++slot) {
+    if (keys_[slot].high != kEmpty) {
+      visit(toDecimal(keys_[slot]), values_[slot]);
+    }
+  }
+}
+
+template <typename Value>
+template <typename Visit>
+void DecimalMap<Value>::forEach(Visit visit) {
+  for (size_t slot = 0; slot < keys_.size(); ++slot) {
+    if (keys_[slot].high != kEmpty) {
+      visit(toDecimal(keys_[slot]), values_[slot]);
+    }
+  }
+}
+
+template <typename Value>
+bool DecimalMap<Value>::makeKey(const Decimal& value, Key& key) noexcept {
+  if (value.getErrorCode()) return false;
+  // values without an error are normalized, only zero has two forms
+  MantissaType mantissa = Access::mantissa(value);
+  uint64_t word = 0;
+  if (mantissa != 0) {
+    word = static_cast<uint64_t>(Access::sign(value)) << 31 |
+           static_cast<uint64_t>(Access::scale(value)) << 16;
+  }
+  key.low = static_cast<uint64_t>(mantissa);
+  key.high = static_cast<uint64_t>(mantissa >> 64) | word << 32;
+  return true;
+}
+
+template <typename Value>
+Decimal DecimalMap<Value>::toDecimal(const Key& key) noexcept {
+  MantissaType mantissa =
+      static_cast<MantissaType>(key.high & 0xFFFFFFFF) << 64 | key.low;
+  Decimal result;
+  Access::assign(result, mantissa, (key.high >> 48) & 0xFF, key.high >> 63);
+  return result;
+}
+
+template <typename Value>
+size_t DecimalMap<Value>::locate(const Key& key) const noexcept {
+  const size_t mask = keys_.size() - 1;
+  size_t slot = home(key);
+  while (keys_[slot].high != kEmpty && !(keys_[slot] == key)) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+template <typename Value>
+size_t DecimalMap<Value>::prepareInsert(const Key& key) {
+  if ((size_ + 1) * 4 > keys_.size() * 3) {
+    rehash(keys_.empty() ? kMinCapacity : keys_.size() * 2);
+  }
+  return locate(key);
+}
+
+template <typename Value>
+void DecimalMap<Value>::rehash(size_t capacity) {
+  std::vector<Key> keys(capacity, Key{0, kEmpty});
+  std::vector<Value> values(capacity);
+  keys.swap(keys_);
+  values.swap(values_);
+  for (size_t slot = 0; slot < keys.size(); ++slot) {
+    if (keys[slot].high != kEmpty) {
+      size_t target = locate(keys[slot]);
+      keys_[target] = keys[slot];
+      values_[target] = std::move(values[slot]);
+    }
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,224 @@
+#include "decimal_parallel.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "decimal_accumulator.h"
+
+namespace s21 {
+
+namespace {
+
+using internal::kMaxScale;
+using MantissaType = Decimal::MantissaType;
+using Access = internal::DecimalAccess;
+
+// Worker threads kept until exit. run() queues a job of parts, starts the
+// workers it can use that are not running yet, and runs the parts no worker
+// has taken on the calling thread.
+class Pool {
+ public:
+  static Pool& instance() {
+    static Pool pool;
+    return pool;
+  }
+
+  ~Pool();
+
+  void run(size_t parts, const std::function<void(size_t)>& task) noexcept;
+
+ private:
+  struct Job {
+    const std::function<void(size_t)>& task;
+    const size_t parts;
+    // the next part to take and the parts not done yet
+    size_t next;
+    size_t left;
+  };
+
+  std::mutex mutex_;
+  // a job is queued or the pool stops
+  std::condition_variable queued_;
+  // a part is done
+  std::condition_variable done_;
+  // jobs with parts to take, the first one taken from first
+  std::deque<Job*> jobs_;
+  std::vector<std::thread> workers_;
+  bool stopping_ = false;
+
+  Pool() = default;
+
+  // takes the next part of job with mutex_ held
+  size_t take(Job& job);
+  void work();
+};
+
+Pool::~Pool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  queued_.notify_all();
+  for (auto& worker : workers_) worker.join();
+}
+
+size_t Pool::take(Job& job) {
+  const size_t part = job.next++;
+  if (job.next == job.parts) {
+    jobs_.erase(std::find(jobs_.begin(), jobs_.end(), &job));
+  }
+  return part;
+}
+
+void Pool::run(size_t parts,
+               const std::function<void(size_t)>& task) noexcept {
+  Job job{task, parts, 1, parts};
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (workers_.size() < parts - 1) {
+    try {
+      workers_.emplace_back(&Pool::work, this);
+    } catch (const std::system_error&) {
+      break;
+    }
+  }
+  jobs_.push_back(&job);
+  for (size_t part = 1; part < parts; ++part) queued_.notify_one();
+  lock.unlock();
+
+  task(0);
+  lock.lock();
+  --job.left;
+  while (job.next < job.parts) {
+    const size_t part = take(job);
+    lock.unlock();
+    task(part);
+    lock.lock();
+    --job.left;
+  }
+  done_.wait(lock, [&job] { return job.left == 0; });
+}
+
+void Pool::work() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    queued_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+    if (jobs_.empty()) return;
+    Job& job = *jobs_.front();
+    const size_t part = take(job);
+    lock.unlock();
+    job.task(part);
+    lock.lock();
+    if (--job.left == 0) done_.notify_all();
+  }
+}
+
+}  // namespace
+
+void DecimalParallel::runTasks(size_t parts,
+                               const std::function<void(size_t)>& task) {
+  Pool::instance().run(parts, task);
+}
+
+size_t DecimalParallel::partCount(size_t size, unsigned threads) noexcept {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return std::max<size_t>(1, std::min<size_t>(threads, size / kMinPart));
+}
+
+template <typename Reduce>
+auto DecimalParallel::reduceParts(size_t size, unsigned threads,
+                                  Reduce reduce) {
+  using Part = decltype(reduce(size_t{0}, size_t{0}));
+  std::vector<Part> results(partCount(size, threads));
+  runParts(size, results.size(),
+           [&](size_t part, size_t first, size_t last) {
+             results[part] = reduce(first, last);
+           });
+  return results;
+}
+
+template <typename Better>
+Decimal DecimalParallel::select(const Decimal* values, size_t size,
+                                unsigned threads, Better better) {
+  if (size == 0) return Decimal();
+
+  // the index of the first error, or else of the first best value
+  auto parts = reduceParts(size, threads, [values, better](size_t first,
+                                                           size_t last) {
+    size_t best = first;
+    for (size_t i = first; i < last; ++i) {
+      if (values[i].getErrorCode()) return i;
+      if (better(values[i].compare(values[best]), 0)) best = i;
+    }
+    return best;
+  });
+  size_t best = parts[0];
+  for (size_t index : parts) {
+    if (values[index].getErrorCode()) return values[index];
+    if (better(values[index].compare(values[best]), 0)) best = index;
+  }
+  return values[best];
+}
+
+Decimal DecimalParallel::sum(const Decimal* values, size_t size,
+                             unsigned threads) {
+  auto parts = reduceParts(size, threads, [values](size_t first, size_t last) {
+    DecimalAccumulator sum;
+    sum.add(values + first, last - first);
+    return sum;
+  });
+  DecimalAccumulator total;
+  for (const auto& part : parts) total.merge(part);
+  return total.result();
+}
+
+Decimal DecimalParallel::min(const Decimal* values, size_t size,
+                             unsigned threads) {
+  return select(values, size, threads, std::less<>());
+}
+
+Decimal DecimalParallel::max(const Decimal* values, size_t size,
+                             unsigned threads) {
+  return select(values, size, threads, std::greater<>());
+}
+
+Decimal DecimalParallel::dot(const Decimal* lhs, const Decimal* rhs,
+                             size_t size, unsigned threads) {
+  auto parts = reduceParts(size, threads, [lhs, rhs](size_t first,
+                                                     size_t last) {
+    DecimalAccumulator sum;
+    for (size_t i = first; i < last; ++i) {
+      const Decimal& left = lhs[i];
+      const Decimal& right = rhs[i];
+      MantissaType lhs_mantissa = Access::mantissa(left);
+      MantissaType rhs_mantissa = Access::mantissa(right);
+      int scale = Access::scale(left) + Access::scale(right);
+      // a product within 96 bits and 28 digits is what operator* returns
+      if ((left.getErrorCode() | right.getErrorCode()) == 0 &&
+          scale <= kMaxScale && ((lhs_mantissa | rhs_mantissa) >> 64) == 0) {
+        MantissaType product =
+            static_cast<MantissaType>(static_cast<uint64_t>(lhs_mantissa)) *
+            static_cast<uint64_t>(rhs_mantissa);
+        if (!internal::overflow(product)) {
+          sum.addTerm(product, scale,
+                      Access::sign(left) != Access::sign(right));
+          continue;
+        }
+      }
+      sum += left * right;
+    }
+    return sum;
+  });
+  DecimalAccumulator total;
+  for (const auto& part : parts) total.merge(part);
+  return total.result();
+}
+
+}  // namespace s21
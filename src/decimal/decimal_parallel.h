@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include "decimal.h"
+
+namespace s21 {
+
+// Reductions over large arrays of Decimal split across threads. The range
+// is cut into contiguous parts, one per thread; every part is reduced on its
+// own and the part results are combined in order. Sums are exact until the
+// final rounding and ties keep the first value, so the result does not
+// depend on the number of threads or on where the parts begin.
+//
+// threads is the number of parts at most, 0 for one per hardware thread.
+// Parts are at least kMinPart values long, so short ranges stay on the
+// calling thread. The parts run on a pool of worker threads, started as
+// calls first need them and kept until exit, and on the calling thread,
+// which also runs every part no worker has taken, all of them if no worker
+// can be started.
+//
+// The first value with an error, in index order, makes it the result.
+class DecimalParallel {
+ public:
+  static constexpr size_t kMinPart = size_t{1} << 16;
+
+  // Exact sum rounded once, as DecimalAccumulator::result().
+  static Decimal sum(const Decimal* values, size_t size, unsigned threads = 0);
+  // The first of the smallest or largest values, zero for an empty range.
+  static Decimal min(const Decimal* values, size_t size, unsigned threads = 0);
+  static Decimal max(const Decimal* values, size_t size, unsigned threads = 0);
+  // Exact sum of the products lhs[i] * rhs[i], each rounded as by
+  // operator*; products that need no rounding, the common case, are added
+  // as 128-bit integers.
+  static Decimal dot(const Decimal* lhs, const Decimal* rhs, size_t size,
+                     unsigned threads = 0);
+
+ private:
+  friend class DecimalSort;
+
+  // The number of parts [0, size) is cut into for threads.
+  static size_t partCount(size_t size, unsigned threads) noexcept;
+  // Runs body(part, first, last) for each of parts contiguous parts of
+  // [0, size), the first one on the calling thread.
+  template <typename Body>
+  static void runParts(size_t size, size_t parts, Body body);
+  // Runs task(part) for every part in [0, parts) on the pool and the calling
+  // thread, and returns when all of them are done.
+  static void runTasks(size_t parts, const std::function<void(size_t)>& task);
+  // Splits [0, size) into parts, runs reduce(first, last) for each of them
+  // and returns the part results in order.
+  template <typename Reduce>
+  static auto reduceParts(size_t size, unsigned threads, Reduce reduce);
+  template <typename Better>
+  static Decimal select(const Decimal* values, size_t size, unsigned threads,
+                        Better better);
+};
+
+template <typename Body>
+void DecimalParallel::runParts(size_t size, size_t parts, Body body) {
+  auto run = [&](size_t part) {
+    body(part, size * part / parts, size * (part + 1) / parts);
+  };
+
+  if (parts == 1) {
+    run(0);
+  } else {
+    // a std::function of a reference does not allocate
+    runTasks(parts, std::ref(run));
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,340 @@
+#include "decimal_parser.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define S21_PARSER_X86
+#endif
+
+namespace s21 {
+
+// A field recognised by a vector kernel: its length up to the separator and
+// the normalized value.
+struct DecimalParser::FastField {
+  int length;
+  Decimal::MantissaType mantissa;
+  int scale;
+  bool sign;
+};
+
+namespace {
+
+using MantissaType = Decimal::MantissaType;
+using Access = internal::DecimalAccess;
+using internal::kMaxPowerOfTen64;
+using internal::kMaxScale;
+using internal::kPowersOfTen;
+using internal::kValueBits;
+
+// The vector kernels look at this many bytes from the start of a field.
+constexpr int kWindow = 32;
+// Up to 29 significant digits fit into the mantissa type; the kernels leave
+// values above 96 bits, which need rounding, to from_chars.
+constexpr int kFastDigits = internal::kMaxDigits;
+
+MantissaType scaleUp(MantissaType value, int digits) noexcept {
+  if (digits > kMaxPowerOfTen64) {
+    value *= static_cast<uint64_t>(kPowersOfTen[kMaxPowerOfTen64]);
+    digits -= kMaxPowerOfTen64;
+  }
+  return value * static_cast<uint64_t>(kPowersOfTen[digits]);
+}
+
+// Character classes of a window, bit i standing for byte i.
+struct WindowMasks {
+  uint32_t digits;
+  uint32_t separators;
+  uint32_t zeros;
+};
+
+// Positions of the parts of [sign] digits [. digits] within a window, with
+// trailing fractional zeros already cut off.
+struct FieldLayout {
+  int length;
+  bool sign;
+  int int_end, int_digits;
+  int frac_end, frac_digits;
+};
+
+// Checks that the field at the start of the window is a number short
+// enough for the fast path and locates its parts.
+inline bool layoutField(const char* ptr, const WindowMasks& masks,
+                        FieldLayout& layout) noexcept {
+  if (!masks.separators) return false;
+  int length = __builtin_ctz(masks.separators);
+  if (length == 0) return false;
+
+  int begin = (*ptr == '-' || *ptr == '+') ? 1 : 0;
+  uint32_t field = (1U << length) - 1;
+  uint32_t body = field & ~((1U << begin) - 1);
+  uint32_t non_digits = body & ~masks.digits;
+
+  int int_end = non_digits ? __builtin_ctz(non_digits) : length;
+  int frac_begin = length;
+  if (int_end < length) {
+    if (ptr[int_end] != '.' || (non_digits & (non_digits - 1))) return false;
+    frac_begin = int_end + 1;
+  }
+  int int_digits = int_end - begin;
+  if (int_digits + length - frac_begin == 0) return false;
+
+  uint32_t frac_nonzero = field & ~((1U << frac_begin) - 1) & ~masks.zeros;
+  int frac_end = frac_nonzero ? 32 - __builtin_clz(frac_nonzero) : frac_begin;
+
+  // digits from the first non-zero one up to frac_end
+  uint32_t digits = body & masks.digits & ((1ULL << frac_end) - 1);
+  uint32_t nonzero = digits & ~masks.zeros;
+  int significant =
+      nonzero ? __builtin_popcount(digits >> __builtin_ctz(nonzero)) : 0;
+  if (significant > kFastDigits || frac_end - frac_begin > kMaxScale) {
+    return false;
+  }
+
+  layout = {length,  *ptr == '-', int_end, int_digits,
+            frac_end, frac_end - frac_begin};
+  return true;
+}
+
+// Combines four 8-digit groups, most significant first.
+inline MantissaType combineGroups(uint32_t g0, uint32_t g1, uint32_t g2,
+                                  uint32_t g3) noexcept {
+  uint64_t high = static_cast<uint64_t>(g0) * 100000000 + g1;
+  uint64_t low = static_cast<uint64_t>(g2) * 100000000 + g3;
+  return static_cast<MantissaType>(high) * kPowersOfTen[16] + low;
+}
+
+#ifdef S21_PARSER_X86
+
+// The conversions load the 32 bytes before the end of a digit run. Fields
+// closer than that to the start of the buffer are copied after 32 bytes of
+// padding first.
+struct alignas(32) PaddedWindow {
+  char bytes[2 * kWindow];
+
+  const char* fill(const char* ptr) noexcept {
+    std::memset(bytes, '0', kWindow);
+    std::memcpy(bytes + kWindow, ptr, kWindow);
+    return bytes + kWindow;
+  }
+};
+
+// Value of the digits in the `count` bytes before `end`. The digits are
+// converted in 8-digit groups: neighbouring digits, pairs and quads are
+// merged with one multiply-add each.
+__attribute__((target("avx2"), always_inline)) inline MantissaType
+convertAvx2(const char* end, int count) noexcept {
+  if (count == 0) return 0;
+  const __m256i index =
+      _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                       16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29,
+                       30, 31);
+  __m256i digits = _mm256_loadu_si256(
+      reinterpret_cast<const __m256i*>(end - kWindow));
+  digits = _mm256_sub_epi8(digits, _mm256_set1_epi8('0'));
+  digits = _mm256_and_si256(
+      digits, _mm256_cmpgt_epi8(index, _mm256_set1_epi8(31 - count)));
+
+  __m256i groups = _mm256_maddubs_epi16(digits, _mm256_set1_epi16(0x010A));
+  groups = _mm256_madd_epi16(groups, _mm256_set1_epi32(0x00010064));
+  groups = _mm256_packus_epi32(groups, groups);
+  groups = _mm256_madd_epi16(groups, _mm256_set1_epi32(0x00012710));
+  return combineGroups(_mm256_extract_epi32(groups, 0),
+                       _mm256_extract_epi32(groups, 1),
+                       _mm256_extract_epi32(groups, 4),
+                       _mm256_extract_epi32(groups, 5));
+}
+
+// Same as convertAvx2, on two 16-byte halves.
+__attribute__((target("sse4.2"), always_inline)) inline MantissaType
+convertSse42(const char* end, int count) noexcept {
+  if (count == 0) return 0;
+  const __m128i index =
+      _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  const __m128i threshold = _mm_set1_epi8(31 - count);
+  uint32_t groups[4];
+  for (int half = 0; half < 2; ++half) {
+    __m128i digits = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(end - kWindow + 16 * half));
+    digits = _mm_sub_epi8(digits, _mm_set1_epi8('0'));
+    digits = _mm_and_si128(
+        digits,
+        _mm_cmpgt_epi8(_mm_add_epi8(index, _mm_set1_epi8(16 * half)),
+                       threshold));
+    __m128i merged = _mm_maddubs_epi16(digits, _mm_set1_epi16(0x010A));
+    merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00010064));
+    merged = _mm_packus_epi32(merged, merged);
+    merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00012710));
+    groups[2 * half] = _mm_cvtsi128_si32(merged);
+    groups[2 * half + 1] = _mm_extract_epi32(merged, 1);
+  }
+  return combineGroups(groups[0], groups[1], groups[2], groups[3]);
+}
+
+#endif
+
+const char* findSeparator(const char* ptr, const char* last,
+                          char delimiter) noexcept {
+  while (ptr != last && *ptr != delimiter && *ptr != '\n') ++ptr;
+  return ptr;
+}
+
+}  // namespace
+
+#ifdef S21_PARSER_X86
+
+__attribute__((target("avx2"))) bool DecimalParser::scanAvx2(
+    const char* first, const char* ptr, char delimiter,
+    FastField& field) noexcept {
+  __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+
+  __m256i shifted = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+  __m256i digits =
+      _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(9)), shifted);
+  __m256i separators =
+      _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8(delimiter)),
+                      _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\n')));
+  __m256i zeros = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('0'));
+
+  WindowMasks masks{static_cast<uint32_t>(_mm256_movemask_epi8(digits)),
+                    static_cast<uint32_t>(_mm256_movemask_epi8(separators)),
+                    static_cast<uint32_t>(_mm256_movemask_epi8(zeros))};
+  FieldLayout layout;
+  if (!layoutField(ptr, masks, layout)) return false;
+
+  PaddedWindow window;
+  const char* base = ptr - first < kWindow ? window.fill(ptr) : ptr;
+  MantissaType integer = convertAvx2(base + layout.int_end, layout.int_digits);
+  MantissaType fraction =
+      convertAvx2(base + layout.frac_end, layout.frac_digits);
+  field = {layout.length, scaleUp(integer, layout.frac_digits) + fraction,
+           layout.frac_digits, layout.sign};
+  return !(field.mantissa >> kValueBits);
+}
+
+__attribute__((target("sse4.2"))) bool DecimalParser::scanSse42(
+    const char* first, const char* ptr, char delimiter,
+    FastField& field) noexcept {
+  uint32_t masks[3] = {0, 0, 0};
+  for (int half = 0; half < 2; ++half) {
+    __m128i chars =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + 16 * half));
+    __m128i shifted = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    __m128i digits =
+        _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(9)), shifted);
+    __m128i separators =
+        _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(delimiter)),
+                     _mm_cmpeq_epi8(chars, _mm_set1_epi8('\n')));
+    __m128i zeros = _mm_cmpeq_epi8(chars, _mm_set1_epi8('0'));
+    masks[0] |= static_cast<uint32_t>(_mm_movemask_epi8(digits)) << 16 * half;
+    masks[1] |= static_cast<uint32_t>(_mm_movemask_epi8(separators))
+                << 16 * half;
+    masks[2] |= static_cast<uint32_t>(_mm_movemask_epi8(zeros)) << 16 * half;
+  }
+  FieldLayout layout;
+  if (!layoutField(ptr, {masks[0], masks[1], masks[2]}, layout)) return false;
+
+  PaddedWindow window;
+  const char* base = ptr - first < kWindow ? window.fill(ptr) : ptr;
+  MantissaType integer = convertSse42(base + layout.int_end, layout.int_digits);
+  MantissaType fraction =
+      convertSse42(base + layout.frac_end, layout.frac_digits);
+  field = {layout.length, scaleUp(integer, layout.frac_digits) + fraction,
+           layout.frac_digits, layout.sign};
+  return !(field.mantissa >> kValueBits);
+}
+
+#endif
+
+DecimalParser::Result DecimalParser::parse(Kernel kernel, const char* first,
+                                           const char* last, char delimiter,
+                                           Decimal* out,
+                                           size_t capacity) noexcept {
+  if (!isSupported(kernel)) kernel = Scalar;
+  switch (kernel) {
+#ifdef S21_PARSER_X86
+    case Avx2:
+      return parseFields<scanAvx2>(first, last, delimiter, out, capacity);
+    case Sse42:
+      return parseFields<scanSse42>(first, last, delimiter, out, capacity);
+#endif
+    default:
+      return parseFields<scanNone>(first, last, delimiter, out, capacity);
+  }
+}
+
+DecimalParser::Kernel DecimalParser::bestKernel() noexcept {
+  static const Kernel kernel = isSupported(Avx2)    ? Avx2
+                               : isSupported(Sse42) ? Sse42
+                                                    : Scalar;
+  return kernel;
+}
+
+bool DecimalParser::isSupported(Kernel kernel) noexcept {
+#ifdef S21_PARSER_X86
+  switch (kernel) {
+    case Avx2:
+      return __builtin_cpu_supports("avx2");
+    case Sse42:
+      return __builtin_cpu_supports("sse4.2");
+    default:
+      return true;
+  }
+#else
+  return kernel == Scalar;
+#endif
+}
+
+const char* DecimalParser::kernelName(Kernel kernel) noexcept {
+  switch (kernel) {
+    case Avx2:
+      return "avx2";
+    case Sse42:
+      return "sse4.2";
+    default:
+      return "scalar";
+  }
+}
+
+template <DecimalParser::FastScan kScan>
+DecimalParser::Result DecimalParser::parseFields(const char* first,
+                                                 const char* last,
+                                                 char delimiter, Decimal* out,
+                                                 size_t capacity) noexcept {
+  const char* ptr = first;
+  size_t count = 0;
+  while (ptr != last && count < capacity) {
+    FastField field;
+    const char* end;
+    if (last - ptr >= kWindow && kScan(first, ptr, delimiter, field)) {
+      out[count] = makeValue(field);
+      end = ptr + field.length;
+    } else {
+      end = findSeparator(ptr, last, delimiter);
+      out[count] = parseField(ptr, end);
+    }
+    ++count;
+    ptr = end == last ? end : end + 1;
+  }
+  return {count, ptr};
+}
+
+Decimal DecimalParser::parseField(const char* first,
+                                  const char* last) noexcept {
+  Decimal value;
+  auto [ptr, ec] = from_chars(first, last, value);
+  if (ec == std::errc::invalid_argument || ptr != last) {
+    value = Decimal();
+    Access::setError(value, Decimal::ConvertationError);
+  }
+  return value;
+}
+
+Decimal DecimalParser::makeValue(const FastField& field) noexcept {
+  Decimal value;
+  Access::assign(value, field.mantissa, field.mantissa ? field.scale : 0,
+                 field.sign);
+  return value;
+}
+
+}  // namespace s21
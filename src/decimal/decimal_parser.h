@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "decimal.h"
+
+namespace s21 {
+
+// Bulk parser for text columns: numbers in the from_chars format separated
+// by a delimiter character or a newline. A separator at the very end of the
+// buffer does not start another field. A field that is not a number as a
+// whole yields a value with ConvertationError, one whose integer part does
+// not fit yields an overflow error, and parsing goes on with the next field.
+//
+// Fields that fit into a 32-byte window and have at most 29 significant
+// digits are classified and converted with SSE4.2 or AVX2, picked at run
+// time; all other fields and CPUs without those extensions use from_chars.
+class DecimalParser {
+ public:
+  enum Kernel { Scalar, Sse42, Avx2 };
+
+  struct Result {
+    // number of values written to out
+    size_t count;
+    // start of the first field not parsed, last if the buffer was consumed
+    const char* ptr;
+  };
+
+  static Result parse(const char* first, const char* last, char delimiter,
+                      Decimal* out, size_t capacity) noexcept {
+    return parse(bestKernel(), first, last, delimiter, out, capacity);
+  }
+  static Result parse(std::string_view text, char delimiter, Decimal* out,
+                      size_t capacity) noexcept {
+    return parse(text.data(), text.data() + text.size(), delimiter, out,
+                 capacity);
+  }
+  // Parses with the given kernel, or with Scalar if the CPU lacks it.
+  static Result parse(Kernel kernel, const char* first, const char* last,
+                      char delimiter, Decimal* out, size_t capacity) noexcept;
+
+  static Kernel bestKernel() noexcept;
+  static bool isSupported(Kernel kernel) noexcept;
+  static const char* kernelName(Kernel kernel) noexcept;
+
+ private:
+  struct FastField;
+  using FastScan = bool (*)(const char*, const char*, char, FastField&);
+
+  // Vector kernels: recognise the field at ptr, with at least 32 bytes
+  // readable from it, or return false to leave it to from_chars.
+  static bool scanAvx2(const char* first, const char* ptr, char delimiter,
+                       FastField& field) noexcept;
+  static bool scanSse42(const char* first, const char* ptr, char delimiter,
+                        FastField& field) noexcept;
+  static bool scanNone(const char*, const char*, char, FastField&) noexcept {
+    return false;
+  }
+
+  template <FastScan kScan>
+  static Result parseFields(const char* first, const char* last,
+                            char delimiter, Decimal* out,
+                            size_t capacity) noexcept;
+
+  static Decimal parseField(const char* first, const char* last) noexcept;
+  static Decimal makeValue(const FastField& field) noexcept;
+};
+
+}  // namespace s21
@@ -0,0 +1,261 @@
+#include "decimal_reader.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+#include "decimal_parser.h"
+
+namespace s21 {
+
+DecimalReader::DecimalReader(const std::string& path, char delimiter,
+                             size_t block_size, size_t blocks)
+    : fd_(-1), owns_fd_(true), delimiter_(delimiter), block_size_(block_size) {
+  if (block_size == 0 || blocks < 2) {
+    throw std::invalid_argument("DecimalReader needs two non-empty blocks");
+  }
+  fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd_ < 0) {
+    throw std::system_error(errno, std::generic_category(),
+                            "DecimalReader " + path);
+  }
+  ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+  start(blocks);
+}
+
+DecimalReader::DecimalReader(int fd, char delimiter, size_t block_size,
+                             size_t blocks)
+    : fd_(fd), owns_fd_(false), delimiter_(delimiter), block_size_(block_size) {
+  if (block_size == 0 || blocks < 2) {
+    throw std::invalid_argument("DecimalReader needs two non-empty blocks");
+  }
+  start(blocks);
+}
+
+DecimalReader::~DecimalReader() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  free_cv_.notify_all();
+  if (io_.joinable()) {
+    // a byte in an empty pipe always fits
+    const char byte = 0;
+    [[maybe_unused]] const ssize_t written = ::write(wake_[1], &byte, 1);
+    io_.join();
+  }
+  for (int fd : wake_) {
+    if (fd >= 0) ::close(fd);
+  }
+  if (owns_fd_) ::close(fd_);
+}
+
+size_t DecimalReader::read(Decimal* out, size_t capacity,
+                           std::vector<size_t>* errors) {
+  size_t count = 0;
+  while (count < capacity) {
+    if (pending_ == LongField) {
+      out[count] = Decimal();
+      internal::DecimalAccess::setError(out[count], Decimal::ConvertationError);
+      if (errors) errors->push_back(count_);
+      ++count;
+      ++count_;
+      pending_ = holding_ ? Body : None;
+      continue;
+    }
+    if (cursor_ == segment_end_) {
+      if (!nextSegment()) break;
+      continue;
+    }
+
+    DecimalParser::Result result = DecimalParser::parse(
+        cursor_, segment_end_, delimiter_, out + count, capacity - count);
+    if (errors) {
+      for (size_t i = count; i < count + result.count; ++i) {
+        if (out[i].getErrorCode()) errors->push_back(count_ + i - count);
+      }
+    }
+    count += result.count;
+    count_ += result.count;
+    cursor_ = result.ptr;
+  }
+  return count;
+}
+
+void DecimalReader::start(size_t blocks) {
+  for (size_t i = 0; i < blocks; ++i) {
+    buffers_.emplace_back(new char[block_size_]);
+    free_.push_back(i);
+  }
+  // without a thread of its own, or a pipe to stop it, the reader fills the
+  // buffers on demand
+  if (::pipe2(wake_, O_CLOEXEC) != 0) return;
+  try {
+    io_ = std::thread(&DecimalReader::readBlocks, this);
+  } catch (const std::system_error&) {
+  }
+}
+
+void DecimalReader::readBlocks() {
+  for (;;) {
+    size_t buffer;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      free_cv_.wait(lock, [this] { return stop_ || !free_.empty(); });
+      if (stop_) return;
+      buffer = free_.back();
+      free_.pop_back();
+    }
+    int error = 0;
+    const size_t size = fill(buffers_[buffer].get(), error);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (size != 0) ready_.push_back({buffer, size});
+      if (size == 0 || error != 0) {
+        end_ = true;
+        error_ = error;
+      }
+    }
+    ready_cv_.notify_one();
+    if (size == 0 || error != 0) return;
+  }
+}
+
+size_t DecimalReader::fill(char* buffer, int& error) noexcept {
+  // a read would block the destructor until the input comes, poll() does not
+  pollfd fds[2] = {{fd_, POLLIN, 0}, {wake_[0], POLLIN, 0}};
+  for (;;) {
+    if (::poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) continue;
+      error = errno;
+      return 0;
+    }
+    if (fds[1].revents != 0) return 0;
+    const ssize_t bytes = ::read(fd_, buffer, block_size_);
+    if (bytes >= 0) return static_cast<size_t>(bytes);
+    if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+      error = errno;
+      return 0;
+    }
+  }
+}
+
+bool DecimalReader::takeBlock(Block& block) {
+  if (!io_.joinable()) {
+    if (error_ == 0 && !end_) {
+      const size_t buffer = free_.back();
+      free_.pop_back();
+      block = {buffer, fill(buffers_[buffer].get(), error_)};
+      end_ = block.size == 0 || error_ != 0;
+      if (block.size != 0) return true;
+      free_.push_back(buffer);
+    }
+  } else {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ready_cv_.wait(lock, [this] { return !ready_.empty() || end_; });
+    if (!ready_.empty()) {
+      block = ready_.front();
+      ready_.pop_front();
+      return true;
+    }
+  }
+  if (error_ != 0) {
+    throw std::system_error(error_, std::generic_category(), "DecimalReader");
+  }
+  return false;
+}
+
+void DecimalReader::releaseBlock(size_t buffer) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(buffer);
+  }
+  free_cv_.notify_one();
+}
+
+bool DecimalReader::nextSegment() {
+  if (pending_ == Field) {
+    cursor_ = field_.data();
+    segment_end_ = cursor_ + field_.size();
+    pending_ = holding_ ? Body : None;
+    return true;
+  }
+  if (pending_ == Body) {
+    cursor_ = body_first_;
+    segment_end_ = body_last_;
+    pending_ = None;
+    return true;
+  }
+  if (holding_) {
+    releaseBlock(block_.buffer);
+    holding_ = false;
+  }
+
+  while (!finished_) {
+    Block block;
+    if (!takeBlock(block)) {
+      // the last field has no separator after it
+      finished_ = true;
+      if (long_field_ || carry_.size() > block_size_) {
+        pending_ = LongField;
+      } else if (!carry_.empty()) {
+        field_.swap(carry_);
+        carry_.clear();
+        pending_ = Field;
+      } else {
+        return false;
+      }
+      cursor_ = segment_end_ = nullptr;
+      return true;
+    }
+
+    const char* first = buffers_[block.buffer].get();
+    const char* last = first + block.size;
+    const char* head = std::find_if(
+        first, last, [this](char c) { return isSeparator(c); });
+    if (head == last) {
+      appendCarry(first, last);
+      releaseBlock(block.buffer);
+      continue;
+    }
+    const char* tail = last;
+    while (!isSeparator(tail[-1])) --tail;
+
+    holding_ = true;
+    block_ = block;
+    body_first_ = first;
+    body_last_ = tail;
+    pending_ = Body;
+    if (long_field_ || !carry_.empty()) {
+      // the carried field ends at the first separator of the block
+      appendCarry(first, head + 1);
+      body_first_ = head + 1;
+      pending_ = long_field_ ? LongField : Field;
+      field_.swap(carry_);
+      long_field_ = false;
+    }
+    carry_.assign(tail, last);
+    cursor_ = segment_end_ = nullptr;
+    if (pending_ == LongField) return true;
+    return nextSegment();
+  }
+  return false;
+}
+
+void DecimalReader::appendCarry(const char* first, const char* last) {
+  if (long_field_) return;
+  // the carried field may end with its separator
+  if (carry_.size() + static_cast<size_t>(last - first) > block_size_ + 1) {
+    long_field_ = true;
+    carry_.clear();
+    return;
+  }
+  carry_.append(first, last);
+}
+
+}  // namespace s21
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "decimal.h"
+
+namespace s21 {
+
+// Streaming reader of a text column file, in the format of DecimalParser:
+// numbers separated by a delimiter character or a newline. A thread of its
+// own reads the input in blocks while the caller parses the previous ones,
+// in place, so memory stays at blocks * block_size bytes whatever the size
+// of the input, and pipes and files larger than RAM read the same way. A
+// block is handed over as soon as a read returns anything, so the values of
+// a pipe arrive as their separators do.
+//
+// Every field yields one value, so the values line up with the fields:
+// a field that is not a number yields ConvertationError and one that does
+// not fit an overflow error, exactly as DecimalParser::parse() on the whole
+// text. A field longer than a block yields ConvertationError as well.
+//
+// If no thread can be started the caller reads the blocks itself.
+class DecimalReader {
+ public:
+  static constexpr size_t kDefaultBlockSize = size_t{1} << 20;
+  static constexpr size_t kDefaultBlocks = 4;
+
+  // Reads the file at path. Throws std::system_error if it cannot be
+  // opened and std::invalid_argument for an empty block or fewer than two
+  // blocks.
+  explicit DecimalReader(const std::string& path, char delimiter = ',',
+                         size_t block_size = kDefaultBlockSize,
+                         size_t blocks = kDefaultBlocks);
+  // Reads fd from its current position. fd stays open and must outlive the
+  // reader.
+  explicit DecimalReader(int fd, char delimiter = ',',
+                         size_t block_size = kDefaultBlockSize,
+                         size_t blocks = kDefaultBlocks);
+  DecimalReader(const DecimalReader&) = delete;
+  DecimalReader& operator=(const DecimalReader&) = delete;
+  ~DecimalReader();
+
+  // Reads up to capacity values into out and returns how many, 0 once the
+  // input is exhausted. The index in the stream of every value with an
+  // error is appended to errors unless it is null. Throws std::system_error
+  // if reading the input fails.
+  size_t read(Decimal* out, size_t capacity,
+              std::vector<size_t>* errors = nullptr);
+
+  // values read so far
+  size_t count() const noexcept { return count_; }
+
+ private:
+  struct Block {
+    size_t buffer;
+    size_t size;
+  };
+  // what follows the current segment
+  enum Pending { None, Field, LongField, Body };
+
+  int fd_;
+  bool owns_fd_;
+  char delimiter_;
+  size_t block_size_;
+  std::vector<std::unique_ptr<char[]>> buffers_;
+
+  // shared with the I/O thread
+  std::mutex mutex_;
+  std::condition_variable ready_cv_;
+  std::condition_variable free_cv_;
+  std::deque<Block> ready_;
+  std::vector<size_t> free_;
+  bool end_ = false;
+  bool stop_ = false;
+  int error_ = 0;
+  std::thread io_;
+  // the destructor writes to wake_[1] to stop the I/O thread waiting for
+  // input in fill()
+  int wake_[2] = {-1, -1};
+
+  // The text being parsed, [cursor_, segment_end_): the field carried over
+  // from earlier blocks, then the whole fields of the held block in place.
+  const char* cursor_ = nullptr;
+  const char* segment_end_ = nullptr;
+  Pending pending_ = None;
+  bool holding_ = false;
+  Block block_ = {0, 0};
+  const char* body_first_ = nullptr;
+  const char* body_last_ = nullptr;
+  // the unfinished field at the end of the last block, dropped once it is
+  // longer than a block
+  std::string carry_;
+  bool long_field_ = false;
+  std::string field_;
+  bool finished_ = false;
+  size_t count_ = 0;
+
+  void start(size_t blocks);
+  void readBlocks();
+  // Reads what fd_ has into a buffer, waiting for at least one byte, and
+  // returns the bytes read: 0 at the end of the input, once the destructor
+  // wakes the thread or on an error, whose errno is kept in error.
+  size_t fill(char* buffer, int& error) noexcept;
+  // False at the end of the input.
+  bool takeBlock(Block& block);
+  void releaseBlock(size_t buffer);
+  // Moves to the next segment, false at the end of the input.
+  bool nextSegment();
+  void appendCarry(const char* first, const char* last);
+  bool isSeparator(char c) const noexcept {
+    return c == delimiter_ || c == '\n';
+  }
+};
+
+}  // namespace s21
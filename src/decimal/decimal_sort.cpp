@@ -0,0 +1,139 @@
+#include "decimal_sort.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "decimal_parallel.h"
+
+namespace s21 {
+
+struct DecimalSort::Item {
+  uint64_t high;
+  uint64_t low;
+  size_t index;
+};
+
+namespace {
+
+constexpr int kKeyBytes = Decimal::kOrderedKeySize;
+constexpr int kRadix = 256;
+// Shorter ranges are sorted by comparing keys: there the counting passes, over
+// 256 buckets each, cost more than the comparisons they save.
+constexpr size_t kMinRadixSize = 4096;
+
+using Counts = std::array<size_t, kRadix>;
+
+// byte 0 is the least significant one
+template <typename Item>
+unsigned keyByte(const Item& item, int byte) {
+  uint64_t word = byte < 8 ? item.low : item.high;
+  return static_cast<uint8_t>(word >> (8 * (byte % 8)));
+}
+
+}  // namespace
+
+void DecimalSort::sort(Decimal* values, size_t size, unsigned threads) {
+  std::vector<Item> items = sortedItems(values, size, threads);
+  std::vector<Decimal> sorted(size);
+  const size_t parts = DecimalParallel::partCount(size, threads);
+  DecimalParallel::runParts(size, parts,
+                            [&](size_t, size_t first, size_t last) {
+                              for (size_t i = first; i < last; ++i) {
+                                sorted[i] = values[items[i].index];
+                              }
+                            });
+  std::copy(sorted.begin(), sorted.end(), values);
+}
+
+void DecimalSort::argsort(const Decimal* values, size_t size, size_t* indices,
+                          unsigned threads) {
+  std::vector<Item> items = sortedItems(values, size, threads);
+  for (size_t i = 0; i < size; ++i) indices[i] = items[i].index;
+}
+
+std::vector<DecimalSort::Item> DecimalSort::sortedItems(const Decimal* values,
+                                                        size_t size,
+                                                        unsigned threads) {
+  std::vector<Item> items(size);
+  auto makeItem = [values](size_t i) {
+    // the big-endian key as two native words
+    const Decimal::OrderedKey key = values[i].toOrderedKey();
+    uint64_t high, low;
+    std::memcpy(&high, key.data(), sizeof(high));
+    std::memcpy(&low, key.data() + sizeof(high), sizeof(low));
+    return Item{__builtin_bswap64(high), __builtin_bswap64(low), i};
+  };
+
+  if (size < kMinRadixSize) {
+    for (size_t i = 0; i < size; ++i) items[i] = makeItem(i);
+    // the index keeps equal keys in their order
+    std::sort(items.begin(), items.end(), [](const Item& lhs, const Item& rhs) {
+      if (lhs.high != rhs.high) return lhs.high < rhs.high;
+      if (lhs.low != rhs.low) return lhs.low < rhs.low;
+      return lhs.index < rhs.index;
+    });
+    return items;
+  }
+
+  // the counts of every key byte in every part, taken with the keys
+  const size_t parts = DecimalParallel::partCount(size, threads);
+  std::vector<std::array<Counts, kKeyBytes>> counts(parts);
+  DecimalParallel::runParts(
+      size, parts, [&](size_t part, size_t first, size_t last) {
+        auto& part_counts = counts[part];
+        for (size_t i = first; i < last; ++i) {
+          items[i] = makeItem(i);
+          for (int byte = 0; byte < kKeyBytes; ++byte) {
+            ++part_counts[byte][keyByte(items[i], byte)];
+          }
+        }
+      });
+
+  std::vector<Item> buffer(size);
+  bool moved = false;
+  for (int byte = 0; byte < kKeyBytes; ++byte) {
+    Counts total{};
+    for (const auto& part_counts : counts) {
+      for (int digit = 0; digit < kRadix; ++digit) {
+        total[digit] += part_counts[byte][digit];
+      }
+    }
+    if (*std::max_element(total.begin(), total.end()) == size) continue;
+
+    // a pass moves items between parts, so the parts count this byte again
+    if (parts > 1 && moved) {
+      DecimalParallel::runParts(
+          size, parts, [&](size_t part, size_t first, size_t last) {
+            Counts part_counts{};
+            for (size_t i = first; i < last; ++i) {
+              ++part_counts[keyByte(items[i], byte)];
+            }
+            counts[part][byte] = part_counts;
+          });
+    }
+
+    // each part scatters its items of a digit after those of earlier parts
+    std::vector<Counts> offsets(parts);
+    size_t offset = 0;
+    for (int digit = 0; digit < kRadix; ++digit) {
+      for (size_t part = 0; part < parts; ++part) {
+        offsets[part][digit] = offset;
+        offset += counts[part][byte][digit];
+      }
+    }
+    DecimalParallel::runParts(
+        size, parts, [&](size_t part, size_t first, size_t last) {
+          Counts& next = offsets[part];
+          for (size_t i = first; i < last; ++i) {
+            buffer[next[keyByte(items[i], byte)]++] = items[i];
+          }
+        });
+    items.swap(buffer);
+    moved = true;
+  }
+  return items;
+}
+
+}  // namespace s21
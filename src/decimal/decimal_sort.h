@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "decimal.h"
+
+namespace s21 {
+
+// Sorting of Decimal arrays without compare(): every value is turned into
+// its ordered key (see Decimal::toOrderedKey()) once, and the keys are sorted
+// by an LSD radix sort, a counting pass per key byte. Bytes that are the same
+// in every key, such as the sign of an all-positive column or the low digits
+// of prices with few decimals, are skipped.
+//
+// The order is that of compare() and stable, so equal values such as 0 and
+// -0 keep their relative order. Values with an error come last, by error
+// code.
+//
+// threads works as in DecimalParallel: the number of parts at most, 0 for
+// one per hardware thread, parts of at least DecimalParallel::kMinPart
+// values. The result does not depend on it.
+class DecimalSort {
+ public:
+  static void sort(Decimal* values, size_t size, unsigned threads = 1);
+  // indices[i] = the index of the i-th value in sorted order.
+  static void argsort(const Decimal* values, size_t size, size_t* indices,
+                      unsigned threads = 1);
+
+ private:
+  // an ordered key as two words, and the index of its value
+  struct Item;
+
+  // The items of values in sorted order.
+  static std::vector<Item> sortedItems(const Decimal* values, size_t size,
+                                       unsigned threads);
+};
+
+}  // namespace s21
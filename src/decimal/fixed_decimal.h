@@ -0,0 +1,209 @@
+#pragma once
+
+#include <utility>
+
+#include "decimal.h"
+
+namespace s21 {
+
+// Decimal number with a scale fixed at compile time: the value is an integer
+// count of 10^-Scale units held in a signed 128-bit word. Addition,
+// subtraction and comparison are plain integer operations; multiplication
+// rescales the double-width product once, rounding half to even.
+//
+// Like built-in integers, the raw value must stay within the signed 128-bit
+// range. Conversion to Decimal reports values beyond 96 bits as an overflow.
+template <int Scale>
+class FixedDecimal {
+  static_assert(Scale >= 0 && Scale <= 28, "Scale must be within 0..28");
+
+ public:
+  using MantissaType = Decimal::MantissaType;
+  using RawType = Decimal::SignedMantissaType;
+
+  static constexpr int kScale = Scale;
+  static constexpr MantissaType kUnit = internal::kPowersOfTen[Scale];
+
+  constexpr FixedDecimal() noexcept : raw_(0) {}
+  constexpr explicit FixedDecimal(long value) noexcept
+      : raw_(static_cast<RawType>(value) * static_cast<RawType>(kUnit)) {}
+
+  // Value of raw * 10^-Scale.
+  static constexpr FixedDecimal fromRaw(RawType raw) noexcept {
+    FixedDecimal result;
+    result.raw_ = raw;
+    return result;
+  }
+  constexpr RawType raw() const noexcept { return raw_; }
+
+  // Exact conversion. Returns ConvertationError for a value with an error,
+  // with more than Scale fractional digits or outside the raw range.
+  static constexpr std::pair<FixedDecimal, int> fromDecimal(
+      const Decimal& value) noexcept;
+  // Exact conversion, normalized like any other Decimal; overflow error if
+  // the value needs more than 96 bits.
+  constexpr Decimal toDecimal() const noexcept;
+  constexpr explicit operator Decimal() const noexcept { return toDecimal(); }
+
+  // Conversion to another scale, rounding half to even when it drops
+  // digits.
+  template <int NewScale>
+  constexpr FixedDecimal<NewScale> rescale() const noexcept;
+
+  constexpr FixedDecimal& operator+=(FixedDecimal other) noexcept {
+    raw_ += other.raw_;
+    return *this;
+  }
+  constexpr FixedDecimal& operator-=(FixedDecimal other) noexcept {
+    raw_ -= other.raw_;
+    return *this;
+  }
+  constexpr FixedDecimal& operator*=(long factor) noexcept {
+    raw_ *= factor;
+    return *this;
+  }
+  constexpr FixedDecimal& operator*=(FixedDecimal other) noexcept;
+
+  constexpr FixedDecimal operator-() const noexcept { return fromRaw(-raw_); }
+
+  friend constexpr FixedDecimal operator+(FixedDecimal lhs,
+                                          FixedDecimal rhs) noexcept {
+    return lhs += rhs;
+  }
+  friend constexpr FixedDecimal operator-(FixedDecimal lhs,
+                                          FixedDecimal rhs) noexcept {
+    return lhs -= rhs;
+  }
+  friend constexpr FixedDecimal operator*(FixedDecimal lhs,
+                                          FixedDecimal rhs) noexcept {
+    return lhs *= rhs;
+  }
+  friend constexpr FixedDecimal operator*(FixedDecimal lhs,
+                                          long rhs) noexcept {
+    return lhs *= rhs;
+  }
+
+  friend constexpr bool operator==(FixedDecimal lhs,
+                                   FixedDecimal rhs) noexcept {
+    return lhs.raw_ == rhs.raw_;
+  }
+  friend constexpr bool operator!=(FixedDecimal lhs,
+                                   FixedDecimal rhs) noexcept {
+    return lhs.raw_ != rhs.raw_;
+  }
+  friend constexpr bool operator<(FixedDecimal lhs,
+                                  FixedDecimal rhs) noexcept {
+    return lhs.raw_ < rhs.raw_;
+  }
+  friend constexpr bool operator<=(FixedDecimal lhs,
+                                   FixedDecimal rhs) noexcept {
+    return lhs.raw_ <= rhs.raw_;
+  }
+  friend constexpr bool operator>(FixedDecimal lhs,
+                                  FixedDecimal rhs) noexcept {
+    return lhs.raw_ > rhs.raw_;
+  }
+  friend constexpr bool operator>=(FixedDecimal lhs,
+                                   FixedDecimal rhs) noexcept {
+    return lhs.raw_ >= rhs.raw_;
+  }
+
+ private:
+  using Access = internal::DecimalAccess;
+
+  static constexpr MantissaType kMaxRaw = ~static_cast<MantissaType>(0) >> 1;
+
+  RawType raw_;
+
+  // Divides a magnitude by 10^digits, rounding half to even.
+  static constexpr MantissaType roundDown(MantissaType value,
+                                          int digits) noexcept;
+  template <typename Value>
+  static constexpr MantissaType roundHalfEven(Value quotient, Value remainder,
+                                              Value divisor) noexcept {
+    Value half = divisor / 2;
+    bool up = remainder > half || (remainder == half && (quotient & 1));
+    return static_cast<MantissaType>(quotient) + up;
+  }
+};
+
+template <int Scale>
+constexpr std::pair<FixedDecimal<Scale>, int> FixedDecimal<Scale>::fromDecimal(
+    const Decimal& value) noexcept {
+  int digits = Scale - Access::scale(value);
+  if (value.getErrorCode() || digits < 0) {
+    return {FixedDecimal(), Decimal::ConvertationError};
+  }
+
+  UInt256 raw = UInt256::multiply(Access::mantissa(value),
+                                  internal::kPowersOfTen[digits]);
+  if (!raw.fitsIn128() || raw.low128() > kMaxRaw) {
+    return {FixedDecimal(), Decimal::ConvertationError};
+  }
+  return {fromRaw(internal::withSign(raw.low128(), Access::sign(value))),
+          Decimal::NoErrors};
+}
+
+template <int Scale>
+constexpr Decimal FixedDecimal<Scale>::toDecimal() const noexcept {
+  MantissaType mantissa = internal::magnitude(raw_);
+  int scale = Scale;
+  internal::normalize(mantissa, scale);
+  Decimal result;
+  Access::assign(result, mantissa, scale, raw_ < 0);
+  return result;
+}
+
+template <int Scale>
+template <int NewScale>
+constexpr FixedDecimal<NewScale> FixedDecimal<Scale>::rescale()
+    const noexcept {
+  if constexpr (NewScale >= Scale) {
+    return FixedDecimal<NewScale>::fromRaw(
+        raw_ * static_cast<RawType>(internal::kPowersOfTen[NewScale - Scale]));
+  } else {
+    return FixedDecimal<NewScale>::fromRaw(
+        internal::withSign(
+            roundDown(internal::magnitude(raw_), Scale - NewScale), raw_ < 0));
+  }
+}
+
+template <int Scale>
+constexpr FixedDecimal<Scale>& FixedDecimal<Scale>::operator*=(
+    FixedDecimal other) noexcept {
+  bool negative = (raw_ < 0) != (other.raw_ < 0);
+  MantissaType lhs = internal::magnitude(raw_);
+  MantissaType rhs = internal::magnitude(other.raw_);
+  MantissaType result = 0;
+  if constexpr (Scale == 0) {
+    result = lhs * rhs;
+  } else {
+    UInt256 product = UInt256::multiply(lhs, rhs);
+    if (product.fitsIn128()) {
+      result = roundDown(product.low128(), Scale);
+    } else {
+      // the quotient of a wider product has to fit the raw range anyway
+      MantissaType remainder = product.divide(kUnit);
+      result = roundHalfEven(product.low128(), remainder, kUnit);
+    }
+  }
+  raw_ = internal::withSign(result, negative);
+  return *this;
+}
+
+template <int Scale>
+constexpr typename FixedDecimal<Scale>::MantissaType
+FixedDecimal<Scale>::roundDown(MantissaType value, int digits) noexcept {
+  // with a constant divisor, 64-bit division compiles to a multiplication
+  if (digits <= internal::kMaxPowerOfTen64 && (value >> 64) == 0) {
+    uint64_t divisor = static_cast<uint64_t>(internal::kPowersOfTen[digits]);
+    uint64_t quotient = static_cast<uint64_t>(value) / divisor;
+    uint64_t remainder = static_cast<uint64_t>(value) - quotient * divisor;
+    return roundHalfEven(quotient, remainder, divisor);
+  }
+  MantissaType divisor = internal::kPowersOfTen[digits];
+  MantissaType quotient = value / divisor;
+  return roundHalfEven(quotient, value - quotient * divisor, divisor);
+}
+
+}  // namespace s21
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+#include "decimal.h"
+
+namespace s21 {
+
+// Random-access iterator over a container of Decimal values by index, for
+// containers whose elements are unpacked on access instead of stored:
+// dereferencing returns (*container)[index] as Reference, a Decimal or a
+// proxy that converts to one.
+template <typename Container, typename Reference>
+class IndexIterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = Decimal;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = Reference;
+
+  IndexIterator() noexcept = default;
+  IndexIterator(Container* container, size_t index) noexcept
+      : container_(container), index_(index) {}
+
+  reference operator*() const noexcept { return (*container_)[index_]; }
+  reference operator[](difference_type offset) const noexcept {
+    return (*container_)[index_ + offset];
+  }
+
+  IndexIterator& operator++() noexcept {
+    ++index_;
+    return *this;
+  }
+  IndexIterator operator++(int) noexcept { return {container_, index_++}; }
+  IndexIterator& operator--() noexcept {
+    --index_;
+    return *this;
+  }
+  IndexIterator operator--(int) noexcept { return {container_, index_--}; }
+  IndexIterator& operator+=(difference_type offset) noexcept {
+    index_ += offset;
+    return *this;
+  }
+  IndexIterator& operator-=(difference_type offset) noexcept {
+    index_ -= offset;
+    return *this;
+  }
+
+  friend IndexIterator operator+(IndexIterator it,
+                                 difference_type offset) noexcept {
+    return it += offset;
+  }
+  friend IndexIterator operator+(difference_type offset,
+                                 IndexIterator it) noexcept {
+    return it += offset;
+  }
+  friend IndexIterator operator-(IndexIterator it,
+                                 difference_type offset) noexcept {
+    return it -= offset;
+  }
+  friend difference_type operator-(IndexIterator lhs,
+                                   IndexIterator rhs) noexcept {
+    return static_cast<difference_type>(lhs.index_ - rhs.index_);
+  }
+
+  friend bool operator==(IndexIterator lhs, IndexIterator rhs) noexcept {
+    return lhs.index_ == rhs.index_;
+  }
+  friend bool operator!=(IndexIterator lhs, IndexIterator rhs) noexcept {
+    return lhs.index_ != rhs.index_;
+  }
+  friend bool operator<(IndexIterator lhs, IndexIterator rhs) noexcept {
+    return lhs.index_ < rhs.index_;
+  }
+  friend bool operator<=(IndexIterator lhs, IndexIterator rhs) noexcept {
+    return lhs.index_ <= rhs.index_;
+  }
+  friend bool operator>(IndexIterator lhs, IndexIterator rhs) noexcept {
+    return lhs.index_ > rhs.index_;
+  }
+  friend bool operator>=(IndexIterator lhs, IndexIterator rhs) noexcept {
+    return lhs.index_ >= rhs.index_;
+  }
+
+ private:
+  Container* container_ = nullptr;
+  size_t index_ = 0;
+};
+
+}  // namespace s21
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cstdint>
+
+namespace s21 {
+
+// Fixed-size 256-bit unsigned integer stored as four little-endian 64-bit
+// limbs. Used for intermediate results that do not fit into the 128-bit
+// mantissa type, so it never touches the heap.
+class UInt256 {
+ public:
+  using Limb = uint64_t;
+  using DoubleLimb = __uint128_t;
+
+  static constexpr int kLimbs = 4;
+  static constexpr int kLimbBits = 64;
+
+  constexpr UInt256() noexcept : limbs_{0, 0, 0, 0} {}
+  constexpr explicit UInt256(DoubleLimb value) noexcept
+      : limbs_{static_cast<Limb>(value), static_cast<Limb>(value >> kLimbBits),
+               0, 0} {}
+
+  // Full 128 x 128 -> 256 bit product.
+  static constexpr UInt256 multiply(DoubleLimb lhs, DoubleLimb rhs) noexcept {
+    const Limb a[2] = {static_cast<Limb>(lhs),
+                       static_cast<Limb>(lhs >> kLimbBits)};
+    const Limb b[2] = {static_cast<Limb>(rhs),
+                       static_cast<Limb>(rhs >> kLimbBits)};
+
+    UInt256 result;
+    for (int i = 0; i < 2; ++i) {
+      Limb carry = 0;
+      for (int j = 0; j < 2; ++j) {
+        DoubleLimb t = static_cast<DoubleLimb>(a[i]) * b[j] +
+                       result.limbs_[i + j] + carry;
+        result.limbs_[i + j] = static_cast<Limb>(t);
+        carry = static_cast<Limb>(t >> kLimbBits);
+      }
+      result.limbs_[i + 2] = carry;
+    }
+    return result;
+  }
+
+  // Multiplies in place by a 64-bit factor; the product must fit 256 bits.
+  constexpr void multiply(Limb factor) noexcept {
+    Limb carry = 0;
+    for (int i = 0; i < kLimbs; ++i) {
+      DoubleLimb t = static_cast<DoubleLimb>(limbs_[i]) * factor + carry;
+      limbs_[i] = static_cast<Limb>(t);
+      carry = static_cast<Limb>(t >> kLimbBits);
+    }
+  }
+
+  // Adds in place modulo 2^256.
+  constexpr void add(const UInt256& other) noexcept {
+    Limb carry = 0;
+    for (int i = 0; i < kLimbs; ++i) {
+      DoubleLimb t =
+          static_cast<DoubleLimb>(limbs_[i]) + other.limbs_[i] + carry;
+      limbs_[i] = static_cast<Limb>(t);
+      carry = static_cast<Limb>(t >> kLimbBits);
+    }
+  }
+
+  // Subtracts in place a value not greater than this one.
+  constexpr void subtract(const UInt256& other) noexcept {
+    Limb borrow = 0;
+    for (int i = 0; i < kLimbs; ++i) {
+      DoubleLimb t =
+          static_cast<DoubleLimb>(limbs_[i]) - other.limbs_[i] - borrow;
+      limbs_[i] = static_cast<Limb>(t);
+      borrow = (t >> kLimbBits) != 0;
+    }
+  }
+
+  // -1, 0 or 1 as this value is less than, equal to or greater than other.
+  constexpr int compare(const UInt256& other) const noexcept {
+    for (int i = kLimbs - 1; i >= 0; --i) {
+      if (limbs_[i] != other.limbs_[i]) {
+        return limbs_[i] < other.limbs_[i] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
+  constexpr Limb limb(int index) const noexcept { return limbs_[index]; }
+
+  constexpr bool isZero() const noexcept {
+    return (limbs_[0] | limbs_[1] | limbs_[2] | limbs_[3]) == 0;
+  }
+
+  constexpr bool fitsIn128() const noexcept {
+    return (limbs_[2] | limbs_[3]) == 0;
+  }
+
+  constexpr DoubleLimb low128() const noexcept {
+    return static_cast<DoubleLimb>(limbs_[1]) << kLimbBits | limbs_[0];
+  }
+
+  // Number of significant bits, 0 for zero.
+  constexpr int bitLength() const noexcept {
+    for (int i = kLimbs - 1; i >= 0; --i) {
+      if (limbs_[i]) {
+        return i * kLimbBits + kLimbBits - __builtin_clzll(limbs_[i]);
+      }
+    }
+    return 0;
+  }
+
+  // Shifts right in place by 0..255 bits and returns whether any of the
+  // bits shifted out was set.
+  constexpr bool shiftRight(int bits) noexcept {
+    int limbs = bits / kLimbBits, offset = bits % kLimbBits;
+    bool lost = false;
+    for (int i = 0; i < kLimbs; ++i) {
+      if (i < limbs) {
+        lost |= limbs_[i] != 0;
+      } else if (i == limbs && offset) {
+        lost |= (limbs_[i] << (kLimbBits - offset)) != 0;
+      }
+    }
+    for (int i = 0; i < kLimbs; ++i) {
+      Limb low = i + limbs < kLimbs ? limbs_[i + limbs] : 0;
+      Limb high = i + limbs + 1 < kLimbs ? limbs_[i + limbs + 1] : 0;
+      limbs_[i] = offset ? low >> offset | high << (kLimbBits - offset) : low;
+    }
+    return lost;
+  }
+
+  // Divides in place by a non-zero 64-bit divisor and returns the remainder.
+  constexpr Limb divide(Limb divisor) noexcept {
+    DoubleLimb remainder = 0;
+    for (int i = kLimbs - 1; i >= 0; --i) {
+      DoubleLimb current = remainder << kLimbBits | limbs_[i];
+      limbs_[i] = static_cast<Limb>(current / divisor);
+      remainder = current % divisor;
+    }
+    return static_cast<Limb>(remainder);
+  }
+
+  // Divides in place by a non-zero 128-bit divisor and returns the
+  // remainder. Knuth's algorithm D with 64-bit digits: each quotient digit
+  // is estimated from the top two dividend digits and the top divisor digit,
+  // then corrected at most twice.
+  constexpr DoubleLimb divide(DoubleLimb divisor) noexcept {
+    const Limb high = static_cast<Limb>(divisor >> kLimbBits);
+    if (high == 0) return divide(static_cast<Limb>(divisor));
+
+    // shift both operands so that the top bit of the divisor is set
+    const int shift = __builtin_clzll(high);
+    const DoubleLimb d = divisor << shift;
+    const Limb d1 = static_cast<Limb>(d >> kLimbBits);
+    const Limb d0 = static_cast<Limb>(d);
+    Limb u[kLimbs + 1] = {};
+    for (int i = kLimbs; i >= 0; --i) {
+      Limb current = i < kLimbs ? limbs_[i] << shift : 0;
+      Limb lower = i > 0 && shift ? limbs_[i - 1] >> (kLimbBits - shift) : 0;
+      u[i] = current | lower;
+    }
+
+    Limb quotient[kLimbs] = {};
+    for (int j = kLimbs - 2; j >= 0; --j) {
+      DoubleLimb top =
+          static_cast<DoubleLimb>(u[j + 2]) << kLimbBits | u[j + 1];
+      DoubleLimb q = top / d1, r = top % d1;
+      while ((q >> kLimbBits) || q * d0 > (r << kLimbBits | u[j])) {
+        --q;
+        r += d1;
+        if (r >> kLimbBits) break;
+      }
+
+      // u[j..j+2] -= q * d
+      DoubleLimb low = q * d0;
+      DoubleLimb mid = q * d1 + (low >> kLimbBits);
+      const Limb product[3] = {static_cast<Limb>(low), static_cast<Limb>(mid),
+                               static_cast<Limb>(mid >> kLimbBits)};
+      Limb borrow = 0;
+      for (int i = 0; i < 3; ++i) {
+        DoubleLimb t = static_cast<DoubleLimb>(u[j + i]) - product[i] - borrow;
+        u[j + i] = static_cast<Limb>(t);
+        borrow = static_cast<Limb>(t >> kLimbBits) & 1;
+      }
+
+      // the estimate was one too large, add the divisor back
+      if (borrow) {
+        --q;
+        DoubleLimb t = static_cast<DoubleLimb>(u[j]) + d0;
+        u[j] = static_cast<Limb>(t);
+        t = static_cast<DoubleLimb>(u[j + 1]) + d1 + (t >> kLimbBits);
+        u[j + 1] = static_cast<Limb>(t);
+        u[j + 2] += static_cast<Limb>(t >> kLimbBits);
+      }
+      quotient[j] = static_cast<Limb>(q);
+    }
+
+    for (int i = 0; i < kLimbs; ++i) limbs_[i] = quotient[i];
+    return (static_cast<DoubleLimb>(u[1]) << kLimbBits | u[0]) >> shift;
+  }
+
+ private:
+  Limb limbs_[kLimbs];
+};
+
+}  // namespace s21
@@ -16,6 +16,7 @@ int main() try {
   s21::Decimal d8(&s21_decimal_var);
   s21::Decimal d9 = "-7.9228162514264337593543950335"_d;
   s21::Decimal d10(d9);
+  constexpr s21::Decimal d11 = 1'000.50_dec * "0.0001"_d;
 
   std::cout << "\nПечать\n" << std::endl;
 
@@ -58,6 +59,7 @@ int main() try {
   std::cout << "-3.1415926535"_d.floor() << std::endl;
   std::cout << "3.999999999"_d.truncate() << std::endl;
   std::cout << "3.1415926535"_d.negate() << std::endl;
+  std::cout << d11 << std::endl;
 
 } catch (const std::exception &e) {
   std::cerr << e.what() << std::endl;
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+
+#include "../decimal/decimal_accumulator.h"
+#include "base_test.h"
+#include "exact_digits.h"
+
+namespace s21 {
+
+// Sums values with DecimalAccumulator and checks the result against the
+// exact sum written out in decimal digits and read back with from_chars,
+// which rounds half to even to 96 bits once. "-=" subtracts every value,
+// "merge" sums the two halves apart and merges them, "clear" sums the values
+// once before clear() and once after it.
+class AccumulatorTest : public BaseTest {
+ public:
+  AccumulatorTest(const std::vector<Decimal>& values,
+                  const std::vector<std::string>& operations = {
+                      "+=", "-=", "add", "merge", "clear"})
+      : BaseTest(operations), values_(values) {}
+
+ protected:
+  static constexpr int kScale = 28;
+
+  const std::vector<Decimal> values_;
+  std::string result_, cmp_result_;
+
+  // The exact sum of values, each negated if negate is set, rounded once;
+  // the first value with an error makes its error the result.
+  static Decimal exactSum(const std::vector<Decimal>& values, bool negate) {
+    std::string positive = "0", negative = "0";
+    for (const Decimal& value : values) {
+      if (value.getErrorCode()) return value;
+      std::string& total = (value < 0L) != negate ? negative : positive;
+      total = digits::add(total, digits::scaled(value, kScale));
+    }
+    return digits::toDecimal(positive, negative, kScale);
+  }
+
+  void printArgs() override {
+    printSize(values_.size());
+    for (size_t i = 0; i < std::min<size_t>(values_.size(), 4); ++i) {
+      std::cout << "| value_" << i << "            | " << std::setw(31)
+                << std::right << values_[i] << " |      |" << std::endl;
+    }
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    if (result_ != cmp_result_) {
+      printResults<std::string>(false, result_, cmp_result_);
+      return false;
+    }
+    if (PrintAllResults) {
+      printResults<std::string>(true, result_, cmp_result_);
+    }
+
+    return true;
+  }
+
+  int perform_c() override {
+    Decimal result = exactSum(values_, operation_ == "-=");
+    cmp_result_ = describe(result);
+
+    return result.getErrorCode();
+  }
+
+  int perform_cpp() override {
+    DecimalAccumulator sum;
+    if (operation_ == "+=" || operation_ == "clear") {
+      for (const Decimal& value : values_) sum += value;
+    } else if (operation_ == "-=") {
+      for (const Decimal& value : values_) sum -= value;
+    }
+    if (operation_ == "clear") {
+      sum.clear();
+      sum.add(values_.data(), values_.size());
+    } else if (operation_ == "add") {
+      sum.add(values_.data(), values_.size());
+    } else if (operation_ == "merge") {
+      const size_t half = values_.size() / 2;
+      DecimalAccumulator tail;
+      sum.add(values_.data(), half);
+      tail.add(values_.data() + half, values_.size() - half);
+      sum.merge(tail);
+    }
+    Decimal result = sum.result();
+    result_ = describe(result);
+
+    return result.getErrorCode();
+  }
+};
+
+}  // namespace s21
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "../decimal/decimal_batch.h"
 #include "base_test.h"
+#include "exact_digits.h"
 
 namespace s21 {
 
@@ -110,4 +112,161 @@ class ArithmeticTestDiv : public ArithmeticTest {
       : ArithmeticTest(lhs, rhs, {"/"}) {}
 };
 
+// Checks checked:: and unchecked:: against the operators: checked:: stores
+// the result of the operator and returns true exactly when it has an error
+// code, unchecked:: returns the same result for operands without an error.
+class CheckedTest : public BaseTest {
+ public:
+  CheckedTest(const Decimal& lhs, const Decimal& rhs)
+      : BaseTest({"+", "-", "*", "/"}), lhs_(lhs), rhs_(rhs) {}
+
+ protected:
+  const Decimal lhs_, rhs_;
+  std::string result_, cmp_result_;
+
+  bool validOperands() const {
+    return !lhs_.getErrorCode() && !rhs_.getErrorCode();
+  }
+
+  void printArgs() override {
+    std::cout << "| value_1            | " << std::setw(31) << std::right
+              << lhs_ << " |      |" << std::endl;
+    std::cout << "| value_2            | " << std::setw(31) << std::right
+              << rhs_ << " |      |" << std::endl;
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    if (result_ != cmp_result_) {
+      printResults<std::string>(false, result_, cmp_result_);
+      return false;
+    }
+    if (PrintAllResults) {
+      printResults<std::string>(true, result_, cmp_result_);
+    }
+
+    return true;
+  }
+
+  int perform_c() override {
+    Decimal result;
+    if (operation_ == "+") {
+      result = lhs_ + rhs_;
+    } else if (operation_ == "-") {
+      result = lhs_ - rhs_;
+    } else if (operation_ == "*") {
+      result = lhs_ * rhs_;
+    } else if (operation_ == "/") {
+      result = lhs_ / rhs_;
+    }
+    cmp_result_ = describe(result);
+    if (validOperands()) cmp_result_ += " unchecked " + describe(result);
+
+    return result.getErrorCode() != 0;
+  }
+
+  int perform_cpp() override {
+    Decimal result = 42L, unchecked_result;
+    bool failed = false;
+    if (operation_ == "+") {
+      failed = checked::add(lhs_, rhs_, &result);
+      if (validOperands()) unchecked_result = unchecked::add(lhs_, rhs_);
+    } else if (operation_ == "-") {
+      failed = checked::sub(lhs_, rhs_, &result);
+      if (validOperands()) unchecked_result = unchecked::sub(lhs_, rhs_);
+    } else if (operation_ == "*") {
+      failed = checked::mul(lhs_, rhs_, &result);
+      if (validOperands()) unchecked_result = unchecked::mul(lhs_, rhs_);
+    } else if (operation_ == "/") {
+      failed = checked::div(lhs_, rhs_, &result);
+      if (validOperands()) unchecked_result = unchecked::div(lhs_, rhs_);
+    }
+    result_ = describe(result);
+    if (validOperands()) result_ += " unchecked " + describe(unchecked_result);
+
+    return failed;
+  }
+};
+
+// Checks Decimal::fma and a DecimalBatch::fma of one element against the
+// exact a * b + c rounded once. The first operand with an error, if any,
+// gives the code, even where a * b alone overflows.
+class FmaTest : public BaseTest {
+ public:
+  FmaTest(const Decimal& a, const Decimal& b, const Decimal& c)
+      : BaseTest({"fma", "batch_fma"}), a_(a), b_(b), c_(c) {}
+
+ protected:
+  static constexpr int kScale = 56;
+
+  const Decimal a_, b_, c_;
+  std::string result_, cmp_result_;
+
+  void printArgs() override {
+    std::cout << "| value_1            | " << std::setw(31) << std::right
+              << a_ << " |      |" << std::endl;
+    std::cout << "| value_2            | " << std::setw(31) << std::right
+              << b_ << " |      |" << std::endl;
+    std::cout << "| value_3            | " << std::setw(31) << std::right
+              << c_ << " |      |" << std::endl;
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    if (result_ != cmp_result_) {
+      printResults<std::string>(false, result_, cmp_result_);
+      return false;
+    }
+    if (PrintAllResults) {
+      printResults<std::string>(true, result_, cmp_result_);
+    }
+
+    return true;
+  }
+
+  int perform_c() override {
+    Decimal result;
+    if (a_.getErrorCode()) {
+      result = a_;
+    } else if (b_.getErrorCode()) {
+      result = b_;
+    } else if (c_.getErrorCode()) {
+      result = c_;
+    } else {
+      std::string positive = "0", negative = "0";
+      ((a_ < 0L) != (b_ < 0L) ? negative : positive) =
+          digits::multiply(digits::scaled(a_, kScale / 2),
+                           digits::scaled(b_, kScale / 2));
+      std::string& total = c_ < 0L ? negative : positive;
+      total = digits::add(total, digits::scaled(c_, kScale));
+      result = digits::toDecimal(positive, negative, kScale);
+    }
+    cmp_result_ = describeUnsignedZero(result);
+
+    return result.getErrorCode();
+  }
+
+  int perform_cpp() override {
+    Decimal result;
+    if (operation_ == "fma") {
+      result = Decimal::fma(a_, b_, c_);
+    } else if (operation_ == "batch_fma") {
+      uint8_t error = 0xFF;
+      size_t failed = DecimalBatch::fma(&a_, &b_, &c_, &result, 1, &error);
+      if (error != result.getErrorCode() || failed != (error != 0)) {
+        return -1;
+      }
+    }
+    result_ = describeUnsignedZero(result);
+
+    return result.getErrorCode();
+  }
+};
+
 }  // namespace s21
\ No newline at end of file
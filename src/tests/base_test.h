@@ -2,6 +2,7 @@
 
 #include <iomanip>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include "../decimal/decimal.h"
@@ -65,6 +66,25 @@ class BaseTest {
   virtual int perform_cpp() = 0;
   virtual bool checking() = 0;
 
+  // The value as the tests compare it: its string or its error code.
+  static std::string describe(const Decimal& value) {
+    if (value.getErrorCode()) {
+      return "error " + std::to_string(value.getErrorCode());
+    }
+    return value.toString();
+  }
+
+  // The same with -0 read as 0, for results whose zero has no sign.
+  static std::string describeUnsignedZero(const Decimal& value) {
+    return !value.getErrorCode() && value == 0L ? "0" : describe(value);
+  }
+
+  // The printArgs() row for the number of values.
+  static void printSize(size_t size) {
+    std::cout << "| size               | " << std::setw(31) << std::right
+              << size << " |      |" << std::endl;
+  }
+
   static s21_decimal convert_to_s21(const Decimal& value) {
     s21_decimal s;
     value.to_s21_decimal(&s);
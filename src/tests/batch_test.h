@@ -0,0 +1,155 @@
+#pragma once
+
+#include "../decimal/decimal_batch.h"
+#include "base_test.h"
+
+namespace s21 {
+
+// Runs DecimalBatch over two columns of equal size and checks every result,
+// its entry in the errors array and the returned failure count against the
+// scalar operators. Broadcast passes the first value of rhs for the right
+// operand, and for the addend of fma; InPlace writes the results over the
+// left column and passes no errors array. The fma addend of the other modes
+// is rhs reversed.
+class BatchTest : public BaseTest {
+ public:
+  enum Mode { Arrays, Broadcast, InPlace };
+
+  BatchTest(const std::vector<Decimal>& lhs, const std::vector<Decimal>& rhs,
+            Mode mode = Arrays,
+            const std::vector<std::string>& operations = {"+", "-", "*", "/",
+                                                          "fma", "round",
+                                                          "compare"})
+      : BaseTest(operations), lhs_(lhs), rhs_(rhs), mode_(mode) {}
+
+ protected:
+  const std::vector<Decimal> lhs_, rhs_;
+  const Mode mode_;
+  std::vector<std::string> result_, cmp_result_;
+
+  const Decimal& rhsAt(size_t index) const {
+    return mode_ == Broadcast ? rhs_[0] : rhs_[index];
+  }
+
+  const Decimal& addendAt(size_t index) const {
+    return mode_ == Broadcast ? rhs_[0] : rhs_[rhs_.size() - 1 - index];
+  }
+
+  void printArgs() override {
+    static const char* const kModes[] = {"arrays", "broadcast", "in place"};
+    printSize(lhs_.size());
+    std::cout << "| mode               | " << std::setw(31) << std::right
+              << kModes[mode_] << " |      |" << std::endl;
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    for (size_t i = 0; i < cmp_result_.size(); ++i) {
+      if (result_[i] != cmp_result_[i]) {
+        printResults<std::string>(false, "#" + std::to_string(i) + " " +
+                                             result_[i],
+                                  cmp_result_[i]);
+        return false;
+      }
+    }
+    if (PrintAllResults) {
+      printResults<int>(true);
+    }
+
+    return true;
+  }
+
+  int perform_c() override {
+    cmp_result_.clear();
+    int failed = 0;
+    for (size_t i = 0; i < lhs_.size(); ++i) {
+      const Decimal& lhs = lhs_[i];
+      Decimal result;
+      if (operation_ == "+") {
+        result = lhs + rhsAt(i);
+      } else if (operation_ == "-") {
+        result = lhs - rhsAt(i);
+      } else if (operation_ == "*") {
+        result = lhs * rhsAt(i);
+      } else if (operation_ == "/") {
+        result = lhs / rhsAt(i);
+      } else if (operation_ == "fma") {
+        result = Decimal::fma(lhs, rhs_[i], addendAt(i));
+      } else if (operation_ == "round") {
+        result = lhs.round();
+      } else if (operation_ == "compare") {
+        cmp_result_.push_back(std::to_string(lhs.compare(rhsAt(i))));
+        continue;
+      }
+      cmp_result_.push_back(describe(result));
+      failed += result.getErrorCode() != 0;
+    }
+
+    return failed;
+  }
+
+  int perform_cpp() override {
+    const size_t size = lhs_.size();
+    std::vector<Decimal> out(size);
+    if (mode_ == InPlace) out = lhs_;
+    const Decimal* lhs = mode_ == InPlace ? out.data() : lhs_.data();
+    const Decimal* rhs = rhs_.data();
+    const bool broadcast = mode_ == Broadcast;
+    // entries the batch leaves unwritten show up as 255
+    std::vector<uint8_t> codes(size, 0xFF);
+    uint8_t* errors = mode_ == InPlace ? nullptr : codes.data();
+
+    result_.clear();
+    if (operation_ == "compare") {
+      std::vector<int8_t> signs(size);
+      if (broadcast) {
+        DecimalBatch::compare(lhs, rhs_[0], signs.data(), size);
+      } else {
+        DecimalBatch::compare(lhs, rhs, signs.data(), size);
+      }
+      for (int8_t sign : signs) result_.push_back(std::to_string(sign));
+      return 0;
+    }
+
+    size_t failed = 0;
+    if (operation_ == "+") {
+      failed = broadcast
+                   ? DecimalBatch::add(lhs, rhs_[0], out.data(), size, errors)
+                   : DecimalBatch::add(lhs, rhs, out.data(), size, errors);
+    } else if (operation_ == "-") {
+      failed = broadcast
+                   ? DecimalBatch::sub(lhs, rhs_[0], out.data(), size, errors)
+                   : DecimalBatch::sub(lhs, rhs, out.data(), size, errors);
+    } else if (operation_ == "*") {
+      failed = broadcast
+                   ? DecimalBatch::mul(lhs, rhs_[0], out.data(), size, errors)
+                   : DecimalBatch::mul(lhs, rhs, out.data(), size, errors);
+    } else if (operation_ == "/") {
+      failed = broadcast
+                   ? DecimalBatch::div(lhs, rhs_[0], out.data(), size, errors)
+                   : DecimalBatch::div(lhs, rhs, out.data(), size, errors);
+    } else if (operation_ == "fma") {
+      std::vector<Decimal> addend(rhs_.rbegin(), rhs_.rend());
+      failed = broadcast ? DecimalBatch::fma(lhs, rhs, rhs_[0], out.data(),
+                                             size, errors)
+                         : DecimalBatch::fma(lhs, rhs, addend.data(),
+                                             out.data(), size, errors);
+    } else if (operation_ == "round") {
+      failed = DecimalBatch::round(lhs, out.data(), size, errors);
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+      result_.push_back(describe(out[i]));
+      if (errors && errors[i] != out[i].getErrorCode()) {
+        result_.back() += " errors[i] = " + std::to_string(errors[i]);
+      }
+    }
+
+    return static_cast<int>(failed);
+  }
+};
+
+}  // namespace s21
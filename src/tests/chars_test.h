@@ -0,0 +1,133 @@
+#pragma once
+
+#include "base_test.h"
+
+namespace s21 {
+
+// Parses text with from_chars and checks the value, the error code and the
+// number of characters consumed against the expected ones.
+class FromCharsTest : public BaseTest {
+ public:
+  // the value from_chars starts from, kept on errc::invalid_argument
+  static inline const Decimal kInitial = "42"_d;
+
+  FromCharsTest(const std::string& text, const Decimal& expected,
+                std::errc ec = std::errc(), int length = -1)
+      : BaseTest({"from_chars"}),
+        text_(text),
+        expected_(expected),
+        expected_ec_(ec),
+        expected_length_(length < 0 ? static_cast<int>(text.size())
+                                    : length) {}
+
+ protected:
+  const std::string text_;
+  const Decimal expected_;
+  const std::errc expected_ec_;
+  const int expected_length_;
+  Decimal result_;
+  int length_ = 0;
+
+  void printArgs() override {
+    std::cout << "| text               | " << std::setw(31) << std::right
+              << text_ << " |      |" << std::endl;
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    // error values print their code, and equal values of different scales
+    // print differently
+    std::string text = result_.toString();
+    std::string cmp_text = expected_.toString();
+    if (text != cmp_text || length_ != expected_length_) {
+      printResults<std::string>(false, text + " @" + std::to_string(length_),
+                                cmp_text + " @" +
+                                    std::to_string(expected_length_));
+      return false;
+    }
+    if (PrintAllResults) {
+      printResults<std::string>(true, text, cmp_text);
+    }
+
+    return true;
+  }
+
+  int perform_c() override { return static_cast<int>(expected_ec_); }
+
+  int perform_cpp() override {
+    result_ = kInitial;
+    const char* first = text_.data();
+    auto [ptr, ec] = from_chars(first, first + text_.size(), result_);
+    length_ = static_cast<int>(ptr - first);
+
+    return static_cast<int>(ec);
+  }
+};
+
+// Writes a value with to_chars into a buffer of the given size and checks
+// it against toString(): the same text if it fits, errc::value_too_large
+// and last otherwise.
+class ToCharsTest : public BaseTest {
+ public:
+  ToCharsTest(const Decimal& value, int size = Decimal::kMaxStringLength)
+      : BaseTest({"to_chars"}), value_(value), size_(size) {}
+
+ protected:
+  const Decimal value_;
+  const int size_;
+  std::string result_, cmp_result_;
+
+  void printArgs() override {
+    std::cout << "| value              | " << std::setw(31) << std::right
+              << value_ << " |      |" << std::endl;
+    std::cout << "| buffer size        | " << std::setw(31) << std::right
+              << size_ << " |      |" << std::endl;
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    if (result_ != cmp_result_) {
+      printResults<std::string>(false, result_, cmp_result_);
+      return false;
+    }
+    if (PrintAllResults) {
+      printResults<std::string>(true, result_, cmp_result_);
+    }
+
+    return true;
+  }
+
+  int perform_c() override {
+    cmp_result_ = value_.toString();
+    if (static_cast<int>(cmp_result_.size()) > size_) {
+      cmp_result_ = "last";
+      return static_cast<int>(std::errc::value_too_large);
+    }
+
+    return 0;
+  }
+
+  int perform_cpp() override {
+    // one guard byte past the end must stay untouched
+    std::vector<char> buffer(size_ + 1, '#');
+    char* last = buffer.data() + size_;
+    auto [ptr, ec] = to_chars(buffer.data(), last, value_);
+    if (buffer[size_] != '#') {
+      result_ = "overrun";
+    } else if (ec == std::errc()) {
+      result_.assign(buffer.data(), ptr);
+    } else {
+      result_ = ptr == last ? "last" : "not last";
+    }
+
+    return static_cast<int>(ec);
+  }
+};
+
+}  // namespace s21
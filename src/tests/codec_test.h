@@ -0,0 +1,188 @@
+#pragma once
+
+#include <stdexcept>
+
+#include "../decimal/decimal_codec.h"
+#include "base_test.h"
+
+namespace s21 {
+
+// Encodes values with DecimalEncoder and decodes them with DecimalDecoder,
+// which must give them back, -0 and error codes included:
+// "push_back" encodes and decodes one value at a time, "append" all at once
+// and in blocks of 7, "release" in two pieces released and concatenated.
+// "truncated" leaves the last value unterminated and "garbage" follows the
+// values with an overlong varint; both decode all values before it and then
+// fail there. "header" checks that streams with a bad header fail at once
+// and that the encoder rejects a bad mode or scale.
+class CodecTest : public BaseTest {
+ public:
+  CodecTest(const std::vector<Decimal>& values, DecimalEncoder::Mode mode,
+            int scale = 0)
+      : BaseTest({"push_back", "append", "release", "truncated", "garbage",
+                  "header"}),
+        values_(values),
+        mode_(mode),
+        scale_(scale) {}
+
+ protected:
+  static constexpr size_t kBlock = 7;
+  static constexpr size_t kGarbage = DecimalEncoder::kMaxValueSize + 1;
+
+  const std::vector<Decimal> values_;
+  const DecimalEncoder::Mode mode_;
+  const int scale_;
+  std::vector<std::string> result_, cmp_result_;
+
+  void printArgs() override {
+    std::cout << "| mode, scale        | " << std::setw(27) << std::right
+              << mode_ << ", " << std::setw(2) << scale_ << " |      |"
+              << std::endl;
+    printSize(values_.size());
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    for (size_t i = 0; i < cmp_result_.size(); ++i) {
+      if (i >= result_.size() || result_[i] != cmp_result_[i]) {
+        printResults<std::string>(
+            false,
+            "#" + std::to_string(i) + " " +
+                (i < result_.size() ? result_[i] : std::string("missing")),
+            cmp_result_[i]);
+        return false;
+      }
+    }
+    if (PrintAllResults) {
+      printResults<int>(true);
+    }
+
+    return true;
+  }
+
+  // decodes bytes one value at a time or in blocks, then how it stopped
+  void decode(const std::vector<uint8_t>& bytes, bool blocks,
+              std::vector<std::string>& out) {
+    DecimalDecoder decoder(bytes.data(), bytes.size());
+    if (decoder.mode() != mode_ || decoder.scale() != scale_) {
+      out.push_back("header differs");
+    }
+    if (blocks) {
+      Decimal block[kBlock];
+      while (size_t count = decoder.decode(block, kBlock)) {
+        for (size_t i = 0; i < count; ++i) out.push_back(describe(block[i]));
+      }
+    } else {
+      Decimal value;
+      while (decoder.next(value)) out.push_back(describe(value));
+    }
+    const size_t left = bytes.data() + bytes.size() - decoder.position();
+    out.push_back(std::string(decoder.done() ? "done" : "stopped") +
+                  (decoder.failed() ? " failed" : "") + ", " +
+                  std::to_string(left) + " bytes left");
+  }
+
+  static std::string decodeFailure(const std::vector<uint8_t>& bytes) {
+    DecimalDecoder decoder(bytes.data(), bytes.size());
+    Decimal value;
+    return decoder.next(value) || !decoder.failed() ? "decoded" : "failed";
+  }
+
+  template <typename Encoder>
+  static std::string construction(Encoder make) {
+    try {
+      make();
+      return "constructed";
+    } catch (const std::invalid_argument&) {
+      return "throws";
+    }
+  }
+
+  int perform_c() override {
+    cmp_result_.clear();
+    if (operation_ == "header") {
+      cmp_result_.assign(6, "failed");
+      cmp_result_.resize(8, "throws");
+      return 0;
+    }
+
+    for (const Decimal& value : values_) cmp_result_.push_back(describe(value));
+    if (operation_ == "truncated") {
+      if (values_.empty()) {
+        cmp_result_.push_back("done, ");
+      } else {
+        cmp_result_.pop_back();
+        cmp_result_.push_back("stopped failed, ");
+      }
+    } else if (operation_ == "garbage") {
+      cmp_result_.push_back("stopped failed, " + std::to_string(kGarbage) +
+                            " bytes left");
+    } else {
+      cmp_result_.push_back("done, 0 bytes left");
+    }
+    if (operation_ == "append") {
+      const std::vector<std::string> once(cmp_result_);
+      cmp_result_.insert(cmp_result_.end(), once.begin(), once.end());
+    }
+
+    return 0;
+  }
+
+  int perform_cpp() override {
+    result_.clear();
+    if (operation_ == "header") {
+      std::vector<uint8_t> bytes = DecimalEncoder(mode_, scale_).release();
+      result_.push_back(decodeFailure({}));
+      for (uint8_t header : {0x03, 0x07, 29 << 2 | 1, 31 << 2 | 2, 1 << 2}) {
+        bytes[0] = header;
+        result_.push_back(decodeFailure(bytes));
+      }
+      result_.push_back(construction([this] { DecimalEncoder(mode_, 29); }));
+      result_.push_back(construction([] {
+        DecimalEncoder(static_cast<DecimalEncoder::Mode>(3));
+      }));
+      return 0;
+    }
+
+    DecimalEncoder encoder(mode_, scale_);
+    std::vector<uint8_t> bytes;
+    if (operation_ == "push_back") {
+      for (const Decimal& value : values_) encoder.push_back(value);
+      bytes = encoder.release();
+    } else if (operation_ == "release") {
+      const size_t half = values_.size() / 2;
+      encoder.append(values_.data(), half);
+      bytes = encoder.release();
+      for (size_t i = half; i < values_.size(); ++i) {
+        encoder.push_back(values_[i]);
+      }
+      std::vector<uint8_t> tail = encoder.release();
+      bytes.insert(bytes.end(), tail.begin(), tail.end());
+    } else {
+      encoder.append(values_.data(), values_.size());
+      bytes.assign(encoder.data(), encoder.data() + encoder.size());
+    }
+
+    if (operation_ == "truncated") {
+      // the last byte continues into nothing
+      if (!values_.empty()) bytes.back() |= 0x80;
+      decode(bytes, false, result_);
+      // how far back the value starts depends on its length
+      std::string& last = result_.back();
+      last.erase(last.find(", ") + 2);
+    } else if (operation_ == "garbage") {
+      bytes.insert(bytes.end(), kGarbage, 0xFF);
+      decode(bytes, true, result_);
+    } else {
+      decode(bytes, false, result_);
+      if (operation_ == "append") decode(bytes, true, result_);
+    }
+
+    return 0;
+  }
+};
+
+}  // namespace s21
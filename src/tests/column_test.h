@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+
+#include "../decimal/decimal_column.h"
+#include "base_test.h"
+
+namespace s21 {
+
+// Fills a DecimalColumn and checks the values it reads back, its shared
+// scale after every store and its reductions against plain Decimal code.
+// "set" pushes the values and then stores replacements[i] over value i,
+// the values rotated by one if there are none; "reference" assigns value
+// n - 1 - i over value i through the element proxy, for i from 0 up.
+class ColumnTest : public BaseTest {
+ public:
+  ColumnTest(const std::vector<Decimal>& values, int scale = 0,
+             const std::vector<Decimal>& replacements = {})
+      : BaseTest(operations(values)),
+        values_(values),
+        scale_(scale),
+        replacements_(replacements.empty() ? rotated(values) : replacements) {}
+
+ protected:
+  const std::vector<Decimal> values_;
+  const int scale_;
+  const std::vector<Decimal> replacements_;
+  std::vector<std::string> result_, cmp_result_;
+
+  static inline const Decimal kMax = "79228162514264337593543950335"_d;
+
+  // What DecimalColumn promises about its shared scale: a store raises it
+  // to the scale of the new value if every value fits 96 bits there, and
+  // the new value must fit 96 bits at the shared scale, otherwise every
+  // value keeps its own scale for good. The stored value is not counted
+  // against its own store.
+  struct Model {
+    std::vector<Decimal> values;
+    int scale;
+    bool shared = true;
+
+    void store(size_t index, const Decimal& value) {
+      values[index] = Decimal();
+      int value_scale = fractionDigits(value);
+      if (shared && value_scale > scale) {
+        for (const Decimal& other : values) shared &= fits(other, value_scale);
+        if (shared) scale = value_scale;
+      }
+      shared &= fits(value, scale);
+      values[index] = value;
+    }
+
+    std::string sharedScale() const {
+      return "shared scale " + std::to_string(shared ? scale : -1);
+    }
+  };
+
+  static std::vector<Decimal> rotated(const std::vector<Decimal>& values) {
+    std::vector<Decimal> result(values);
+    if (!result.empty()) {
+      result.erase(result.begin());
+      result.push_back(values.front());
+    }
+    return result;
+  }
+
+  static Decimal power(int digits) {
+    Decimal result = 1L;
+    for (int i = 0; i < digits; ++i) result *= 10L;
+    return result;
+  }
+
+  // error values have no digits
+  static int fractionDigits(const Decimal& value) {
+    if (value.getErrorCode()) return 0;
+    std::string text = value.toString();
+    size_t point = text.find('.');
+    return point == std::string::npos
+               ? 0
+               : static_cast<int>(text.size() - point - 1);
+  }
+
+  // |value| * 10^scale below 2^96, that is |value| at most the largest
+  // mantissa with scale fractional digits
+  static bool fits(const Decimal& value, int scale) {
+    if (value.getErrorCode()) return true;
+    std::string limit = kMax.toString();
+    if (scale > 0) limit.insert(limit.size() - scale, ".");
+    Decimal bound;
+    from_chars(limit.data(), limit.data() + limit.size(), bound);
+    return -bound <= value && value <= bound;
+  }
+
+  // Sums are checked where a running Decimal sum cannot round: below
+  // 10^(28 - scale) in total at the largest scale.
+  static bool exactSum(const std::vector<Decimal>& values) {
+    int scale = 0;
+    for (const Decimal& value : values) {
+      scale = std::max(scale, fractionDigits(value));
+    }
+    const Decimal count = static_cast<long>(values.size());
+    for (const Decimal& value : values) {
+      if (value.getErrorCode()) continue;
+      Decimal total = (value < 0L ? -value : value) * count;
+      if (total.getErrorCode() || total >= power(28 - scale)) return false;
+    }
+    return true;
+  }
+
+  static std::vector<std::string> operations(
+      const std::vector<Decimal>& values) {
+    std::vector<std::string> result = {"push_back", "set", "reference",
+                                       "min",       "max", "clear"};
+    if (exactSum(values)) result.insert(result.end(), {"sum", "mean"});
+    return result;
+  }
+
+  void printArgs() override {
+    printSize(values_.size());
+    std::cout << "| scale              | " << std::setw(31) << std::right
+              << scale_ << " |      |" << std::endl;
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    for (size_t i = 0; i < cmp_result_.size(); ++i) {
+      if (i >= result_.size() || result_[i] != cmp_result_[i]) {
+        printResults<std::string>(
+            false,
+            "#" + std::to_string(i) + " " +
+                (i < result_.size() ? result_[i] : std::string("missing")),
+            cmp_result_[i]);
+        return false;
+      }
+    }
+    if (PrintAllResults) {
+      printResults<int>(true);
+    }
+
+    return true;
+  }
+
+  int perform_c() override {
+    cmp_result_.clear();
+    Model model{std::vector<Decimal>(values_.size()), scale_};
+    for (size_t i = 0; i < values_.size(); ++i) {
+      model.store(i, values_[i]);
+      cmp_result_.push_back(model.sharedScale());
+    }
+
+    if (operation_ == "set") {
+      for (size_t i = 0; i < replacements_.size(); ++i) {
+        model.store(i, replacements_[i]);
+        cmp_result_.push_back(model.sharedScale());
+      }
+    } else if (operation_ == "reference") {
+      for (size_t i = 0; i < values_.size(); ++i) {
+        model.store(i, Decimal(model.values[values_.size() - 1 - i]));
+        cmp_result_.push_back(model.sharedScale());
+      }
+    } else if (operation_ == "clear") {
+      cmp_result_.push_back("size 0 shared scale " + std::to_string(scale_));
+      return 0;
+    }
+
+    const Decimal* error = nullptr;
+    for (const Decimal& value : model.values) {
+      if (value.getErrorCode()) {
+        error = &value;
+        break;
+      }
+    }
+    if (operation_ == "sum" || operation_ == "mean") {
+      Decimal total;
+      for (const Decimal& value : model.values) total += value;
+      if (operation_ == "mean") {
+        total /= Decimal(static_cast<long>(model.values.size()));
+      }
+      cmp_result_.push_back(describeUnsignedZero(error ? *error : total));
+    } else if (operation_ == "min" || operation_ == "max") {
+      Decimal best;
+      for (size_t i = 0; i < model.values.size(); ++i) {
+        const Decimal& value = model.values[i];
+        if (i == 0 || (operation_ == "min" ? value < best : value > best)) {
+          best = value;
+        }
+      }
+      cmp_result_.push_back(describe(error ? *error : best));
+    } else {
+      for (const Decimal& value : model.values) {
+        cmp_result_.push_back(describe(value));
+      }
+    }
+
+    return 0;
+  }
+
+  int perform_cpp() override {
+    result_.clear();
+    DecimalColumn column(scale_);
+    auto sharedScale = [&column] {
+      return "shared scale " + std::to_string(column.sharedScale());
+    };
+    for (const Decimal& value : values_) {
+      column.push_back(value);
+      result_.push_back(sharedScale());
+    }
+
+    if (operation_ == "set") {
+      for (size_t i = 0; i < replacements_.size(); ++i) {
+        column.set(i, replacements_[i]);
+        result_.push_back(sharedScale());
+      }
+    } else if (operation_ == "reference") {
+      for (size_t i = 0; i < column.size(); ++i) {
+        column[i] = column[column.size() - 1 - i];
+        result_.push_back(sharedScale());
+      }
+    } else if (operation_ == "clear") {
+      column.clear();
+      result_.push_back("size " + std::to_string(column.size()) + " " +
+                        sharedScale());
+      return 0;
+    }
+
+    if (operation_ == "sum") {
+      result_.push_back(describeUnsignedZero(column.sum()));
+    } else if (operation_ == "mean") {
+      result_.push_back(describeUnsignedZero(column.mean()));
+    } else if (operation_ == "min") {
+      result_.push_back(describe(column.min()));
+    } else if (operation_ == "max") {
+      result_.push_back(describe(column.max()));
+    } else {
+      // the const iterators against the proxies of the mutable ones
+      auto proxy = column.begin();
+      for (auto it = column.cbegin(); it != column.cend(); ++it, ++proxy) {
+        result_.push_back(describe(*it));
+        if (describe(*proxy) != result_.back()) result_.back() += " proxy";
+      }
+    }
+
+    return 0;
+  }
+};
+
+}  // namespace s21
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
 #include "base_test.h"
 
 namespace s21 {
@@ -154,6 +158,122 @@ class FromFloatTest : public BaseTest {
   }
 };
 
+// Converts a double with Decimal(double), which rounds to 15 significant
+// digits and then to 28 fractional digits, and checks the text of the result
+// or of its error code; "invalid_argument" stands for the exception.
+class FromDoubleTest : public BaseTest {
+ public:
+  FromDoubleTest(double value, const std::string& expected)
+      : BaseTest({"from_double_to_decimal"}),
+        value_(value),
+        expected_(expected) {}
+
+ protected:
+  const double value_;
+  const std::string expected_;
+  std::string result_;
+
+  void printArgs() override {
+    std::cout << "| value              | " << std::setw(31) << std::right;
+    std::cout << std::scientific << std::setprecision(14) << value_
+              << " |      |" << std::endl;
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    if (result_ != expected_) {
+      printResults<std::string>(false, result_, expected_);
+      return false;
+    }
+    if (PrintAllResults) {
+      printResults<std::string>(true, result_, expected_);
+    }
+
+    return true;
+  }
+
+  int perform_c() override { return 0; }
+
+  int perform_cpp() override {
+    try {
+      result_ = Decimal(value_).toString();
+    } catch (const std::invalid_argument&) {
+      result_ = "invalid_argument";
+    }
+
+    return 0;
+  }
+};
+
+// Checks toDouble() against strtod() of the text, which is correctly
+// rounded, and, for values of at most 15 significant digits, that
+// Decimal(double) gives the value back.
+class ToDoubleTest : public BaseTest {
+ public:
+  ToDoubleTest(const Decimal& value,
+               const std::vector<std::string>& operations = {
+                   "from_decimal_to_double", "double_round_trip"})
+      : BaseTest(operations), value_(value) {}
+
+  ToDoubleTest(const Decimal& value, const char* operation)
+      : ToDoubleTest(value, std::vector<std::string>{operation}) {}
+
+ protected:
+  const Decimal value_;
+  double result_, cmp_result_;
+  std::string text_, cmp_text_;
+
+  void printArgs() override {
+    std::cout << "| value              | " << std::setw(31) << std::right
+              << value_ << " |      |" << std::endl;
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    if (operation_ == "from_decimal_to_double") {
+      // bitwise, so that -0 and 0 differ
+      if (std::memcmp(&result_, &cmp_result_, sizeof(double)) != 0) {
+        std::ostringstream result, cmp_result;
+        result << std::setprecision(17) << result_;
+        cmp_result << std::setprecision(17) << cmp_result_;
+        printResults<std::string>(false, result.str(), cmp_result.str());
+        return false;
+      }
+    } else if (text_ != cmp_text_) {
+      printResults<std::string>(false, text_, cmp_text_);
+      return false;
+    }
+    if (PrintAllResults) {
+      printResults<int>(true);
+    }
+
+    return true;
+  }
+
+  int perform_c() override {
+    cmp_text_ = value_.toString();
+    cmp_result_ = std::strtod(cmp_text_.c_str(), nullptr);
+
+    return value_.getErrorCode() ? 1 : 0;
+  }
+
+  int perform_cpp() override {
+    auto [result, err_code] = value_.toDouble();
+    result_ = result;
+    if (operation_ == "double_round_trip") {
+      text_ = Decimal(result).toString();
+    }
+
+    return err_code ? 1 : 0;
+  }
+};
+
 class FromIntTest : public BaseTest {
  public:
   FromIntTest(const int& value)
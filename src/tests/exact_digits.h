@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "../decimal/decimal.h"
+
+namespace s21 {
+
+// Exact arithmetic on unsigned digit strings, most significant digit first,
+// for the references of results that are rounded only once.
+namespace digits {
+
+// |value| * 10^scale; scale is at least the scale of value.
+inline std::string scaled(const Decimal& value, int scale) {
+  std::string text = value.toString();
+  if (text[0] == '-') text.erase(0, 1);
+  std::string fraction;
+  size_t point = text.find('.');
+  if (point != std::string::npos) {
+    fraction = text.substr(point + 1);
+    text.erase(point);
+  }
+  fraction.resize(scale, '0');
+  return text + fraction;
+}
+
+inline std::string strip(const std::string& digits) {
+  size_t first = digits.find_first_not_of('0');
+  return first == std::string::npos ? "0" : digits.substr(first);
+}
+
+inline int compare(const std::string& lhs, const std::string& rhs) {
+  std::string left = strip(lhs), right = strip(rhs);
+  if (left.size() != right.size()) {
+    return left.size() < right.size() ? -1 : 1;
+  }
+  return left.compare(right) < 0 ? -1 : left == right ? 0 : 1;
+}
+
+inline std::string add(const std::string& lhs, const std::string& rhs) {
+  std::string result;
+  int carry = 0;
+  for (size_t i = 0; i < std::max(lhs.size(), rhs.size()) || carry; ++i) {
+    int digit = carry;
+    if (i < lhs.size()) digit += lhs[lhs.size() - 1 - i] - '0';
+    if (i < rhs.size()) digit += rhs[rhs.size() - 1 - i] - '0';
+    result.push_back(static_cast<char>('0' + digit % 10));
+    carry = digit / 10;
+  }
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+// lhs must not be below rhs
+inline std::string subtract(const std::string& lhs, const std::string& rhs) {
+  std::string result;
+  int borrow = 0;
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    int digit = lhs[lhs.size() - 1 - i] - '0' - borrow;
+    if (i < rhs.size()) digit -= rhs[rhs.size() - 1 - i] - '0';
+    borrow = digit < 0;
+    result.push_back(static_cast<char>('0' + digit + 10 * borrow));
+  }
+  std::reverse(result.begin(), result.end());
+  return strip(result);
+}
+
+inline std::string multiply(const std::string& lhs, const std::string& rhs) {
+  std::vector<int> sums(lhs.size() + rhs.size(), 0);
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    for (size_t j = 0; j < rhs.size(); ++j) {
+      sums[i + j + 1] += (lhs[i] - '0') * (rhs[j] - '0');
+    }
+  }
+  for (size_t i = sums.size() - 1; i > 0; --i) {
+    sums[i - 1] += sums[i] / 10;
+    sums[i] %= 10;
+  }
+  std::string result;
+  for (int digit : sums) result.push_back(static_cast<char>('0' + digit));
+  return strip(result);
+}
+
+// positive - negative, both times 10^scale, read back with from_chars:
+// rounded half to even to 96 bits, an overflow error if it does not fit.
+// An exact zero has no sign.
+inline Decimal toDecimal(const std::string& positive,
+                         const std::string& negative, int scale) {
+  std::string text, magnitude;
+  if (compare(positive, negative) < 0) {
+    text = "-";
+    magnitude = subtract(negative, positive);
+  } else {
+    magnitude = subtract(positive, negative);
+  }
+  if (magnitude == "0") return Decimal();
+  if (magnitude.size() <= static_cast<size_t>(scale)) {
+    magnitude.insert(0, scale + 1 - magnitude.size(), '0');
+  }
+  text += magnitude.substr(0, magnitude.size() - scale) + "." +
+          magnitude.substr(magnitude.size() - scale);
+
+  Decimal result;
+  from_chars(text.data(), text.data() + text.size(), result);
+  return result;
+}
+
+}  // namespace digits
+
+}  // namespace s21
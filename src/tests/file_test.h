@@ -0,0 +1,157 @@
+#pragma once
+
+#include <stdlib.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#include "../decimal/decimal_file.h"
+#include "base_test.h"
+
+namespace s21 {
+
+// Writes values with DecimalFile::write into a new directory and maps them
+// back: "round trip" reads them through operator[], the iterators and, with
+// S21_DECIMAL_COMPACT, data(). "rewrite" writes the values reversed over a
+// file that is still mapped, which keeps reading the old values, and leaves
+// no other file behind. "errors" opens the file cut short, with a bad magic
+// and missing, which throw runtime_error or system_error.
+class FileTest : public BaseTest {
+ public:
+  explicit FileTest(const std::vector<Decimal>& values)
+      : BaseTest({"round trip", "rewrite", "errors"}), values_(values) {}
+
+ protected:
+  const std::vector<Decimal> values_;
+  std::vector<std::string> result_, cmp_result_;
+
+  void printArgs() override {
+    printSize(values_.size());
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    for (size_t i = 0; i < cmp_result_.size(); ++i) {
+      if (i >= result_.size() || result_[i] != cmp_result_[i]) {
+        printResults<std::string>(
+            false,
+            "#" + std::to_string(i) + " " +
+                (i < result_.size() ? result_[i] : std::string("missing")),
+            cmp_result_[i]);
+        return false;
+      }
+    }
+    if (PrintAllResults) {
+      printResults<int>(true);
+    }
+
+    return true;
+  }
+
+  void append(const std::string& prefix, const std::vector<Decimal>& values,
+              std::vector<std::string>& out) {
+    out.push_back(prefix + " size " + std::to_string(values.size()));
+    for (const Decimal& value : values) out.push_back(describe(value));
+  }
+
+  // operator[], the iterators and data() if it is available
+  void read(const DecimalFile& file, std::vector<std::string>& out) {
+    std::vector<Decimal> values;
+    for (size_t i = 0; i < file.size(); ++i) values.push_back(file[i]);
+    append("operator[]", values, out);
+    append("iterators", std::vector<Decimal>(file.begin(), file.end()), out);
+    if (DecimalFile::kInPlace) {
+      append("data()",
+             std::vector<Decimal>(file.data(), file.data() + file.size()),
+             out);
+    } else {
+      out.push_back(file.data() ? "data()" : "data() null");
+    }
+  }
+
+  static std::string open(const std::string& path) {
+    try {
+      DecimalFile file(path);
+      return "opened";
+    } catch (const std::system_error&) {
+      return "system_error";
+    } catch (const std::runtime_error&) {
+      return "runtime_error";
+    }
+  }
+
+  int perform_c() override {
+    cmp_result_.clear();
+    if (operation_ == "errors") {
+      cmp_result_ = {"runtime_error", "runtime_error", "runtime_error",
+                     "system_error"};
+      return 0;
+    }
+
+    append("operator[]", values_, cmp_result_);
+    append("iterators", values_, cmp_result_);
+    if (DecimalFile::kInPlace) {
+      append("data()", values_, cmp_result_);
+    } else {
+      cmp_result_.push_back("data() null");
+    }
+    if (operation_ == "rewrite") {
+      const std::vector<std::string> old(cmp_result_);
+      std::vector<Decimal> reversed(values_.rbegin(), values_.rend());
+      append("rewritten", reversed, cmp_result_);
+      cmp_result_.insert(cmp_result_.end(), old.begin(), old.end());
+      cmp_result_.push_back("1 file");
+    }
+
+    return 0;
+  }
+
+  int perform_cpp() override {
+    result_.clear();
+    char directory[] = "/tmp/s21_file_test.XXXXXX";
+    if (!::mkdtemp(directory)) return -1;
+    const std::string path = std::string(directory) + "/values.bin";
+
+    DecimalFile::write(path, values_.data(), values_.size());
+    if (operation_ == "errors") {
+      const auto size = std::filesystem::file_size(path);
+      std::filesystem::resize_file(path, size - 1);
+      result_.push_back(open(path));
+      std::filesystem::resize_file(path, DecimalFile::kHeaderSize - 1);
+      result_.push_back(open(path));
+      DecimalFile::write(path, values_.data(), values_.size());
+      {
+        std::fstream file(path, std::ios::in | std::ios::out |
+                                    std::ios::binary);
+        file.put('X');
+      }
+      result_.push_back(open(path));
+      result_.push_back(open(path + ".missing"));
+    } else {
+      DecimalFile file(path);
+      read(file, result_);
+      if (operation_ == "rewrite") {
+        std::vector<Decimal> reversed(values_.rbegin(), values_.rend());
+        DecimalFile::write(path, reversed.data(), reversed.size());
+        std::vector<Decimal> values;
+        for (Decimal value : DecimalFile(path)) values.push_back(value);
+        append("rewritten", values, result_);
+        read(file, result_);
+        const auto files = std::distance(
+            std::filesystem::directory_iterator(directory),
+            std::filesystem::directory_iterator());
+        result_.push_back(std::to_string(files) + " file");
+      }
+    }
+
+    std::filesystem::remove_all(directory);
+    return 0;
+  }
+};
+
+}  // namespace s21
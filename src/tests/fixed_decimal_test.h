@@ -0,0 +1,222 @@
+#pragma once
+
+#include "../decimal/fixed_decimal.h"
+#include "base_test.h"
+
+namespace s21 {
+
+// Checks FixedDecimal<Scale> against Decimal arithmetic: conversions are
+// exact, products and rescaling round half to even. Results are only
+// checked where the Decimal reference is exact: sums for operands below
+// 10^(28 - Scale), products for operands below 10^(14 - Scale).
+template <int Scale>
+class FixedDecimalTest : public BaseTest {
+  static_assert(Scale <= 7, "the checks assume no raw value overflows");
+
+ public:
+  using Fixed = FixedDecimal<Scale>;
+
+  static constexpr int kLowerScale = Scale / 2;
+  static constexpr int kUpperScale = Scale + 2;
+
+  FixedDecimalTest(const Decimal& lhs, const Decimal& rhs)
+      : BaseTest(operations(lhs, rhs)), lhs_(lhs), rhs_(rhs) {}
+
+  // Rounds value to scale fractional digits, half to even, with Decimal
+  // operations; value * 10^scale must fit into 96 bits.
+  static Decimal roundHalfEven(const Decimal& value, int scale) {
+    Decimal unit = power(scale);
+    Decimal scaled = value * unit;
+    Decimal whole = scaled.truncate();
+    Decimal rest = scaled - whole;
+    if (rest < 0L) rest = -rest;
+    if (rest > "0.5"_d || (rest == "0.5"_d && whole % 2L != 0L)) {
+      whole += value < 0L ? -1L : 1L;
+    }
+    return whole / unit;
+  }
+
+ protected:
+  const Decimal lhs_, rhs_;
+  std::string result_, cmp_result_;
+
+  static Decimal power(int digits) {
+    Decimal result = 1L;
+    for (int i = 0; i < digits; ++i) result *= 10L;
+    return result;
+  }
+
+  static bool below(const Decimal& value, int digits) {
+    return -power(digits) < value && value < power(digits);
+  }
+
+  // up to Scale fractional digits; for Scale up to 9 every Decimal is
+  // within the raw range
+  static bool converts(const Decimal& value) {
+    if (value.getErrorCode()) return false;
+    std::string text = value.toString();
+    size_t point = text.find('.');
+    return point == std::string::npos ||
+           static_cast<int>(text.size() - point - 1) <= Scale;
+  }
+
+  static std::vector<std::string> operations(const Decimal& lhs,
+                                             const Decimal& rhs) {
+    std::vector<std::string> result = {"from_decimal"};
+    if (converts(lhs) && converts(rhs)) {
+      result.push_back("rescale_up");
+      if (below(lhs, 28 - Scale) && below(rhs, 28 - Scale)) {
+        result.insert(result.end(), {"+", "-"});
+      }
+      if (below(lhs, 28 - kLowerScale)) result.push_back("rescale_down");
+      if (below(lhs, 14 - Scale) && below(rhs, 14 - Scale)) {
+        result.push_back("*");
+      }
+    }
+    return result;
+  }
+
+  void printArgs() override {
+    std::cout << "| value_1            | " << std::setw(31) << std::right
+              << lhs_ << " |      |" << std::endl;
+    std::cout << "| value_2            | " << std::setw(31) << std::right
+              << rhs_ << " |      |" << std::endl;
+    std::cout << "| scale              | " << std::setw(31) << std::right
+              << Scale << " |      |" << std::endl;
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    if (result_ != cmp_result_) {
+      printResults<std::string>(false, result_, cmp_result_);
+      return false;
+    }
+    if (PrintAllResults) {
+      printResults<std::string>(true, result_, cmp_result_);
+    }
+
+    return true;
+  }
+
+  int perform_c() override {
+    cmp_result_.clear();
+    if (operation_ == "from_decimal") {
+      if (!converts(lhs_)) return Decimal::ConvertationError;
+      cmp_result_ = describeUnsignedZero(lhs_);
+    } else if (operation_ == "+") {
+      cmp_result_ = describeUnsignedZero(lhs_ + rhs_);
+    } else if (operation_ == "-") {
+      cmp_result_ = describeUnsignedZero(lhs_ - rhs_);
+    } else if (operation_ == "*") {
+      cmp_result_ = describeUnsignedZero(roundHalfEven(lhs_ * rhs_, Scale));
+    } else if (operation_ == "rescale_down") {
+      cmp_result_ = describeUnsignedZero(roundHalfEven(lhs_, kLowerScale));
+    } else if (operation_ == "rescale_up") {
+      cmp_result_ = describeUnsignedZero(lhs_);
+    }
+
+    return 0;
+  }
+
+  int perform_cpp() override {
+    result_.clear();
+    auto [lhs, lhs_code] = Fixed::fromDecimal(lhs_);
+    auto [rhs, rhs_code] = Fixed::fromDecimal(rhs_);
+    if (operation_ == "from_decimal") {
+      if (lhs_code) return lhs_code;
+      result_ = describeUnsignedZero(lhs.toDecimal());
+    } else if (lhs_code || rhs_code) {
+      return -1;
+    } else if (operation_ == "+") {
+      result_ = describeUnsignedZero((lhs + rhs).toDecimal());
+    } else if (operation_ == "-") {
+      result_ = describeUnsignedZero((lhs - rhs).toDecimal());
+    } else if (operation_ == "*") {
+      result_ = describeUnsignedZero((lhs * rhs).toDecimal());
+    } else if (operation_ == "rescale_down") {
+      result_ = describeUnsignedZero(
+          lhs.template rescale<kLowerScale>().toDecimal());
+    } else if (operation_ == "rescale_up") {
+      result_ = describeUnsignedZero(
+          lhs.template rescale<kUpperScale>().toDecimal());
+    }
+
+    return 0;
+  }
+};
+
+// Conversions at the edges of the raw and the Decimal ranges, with the
+// expected results written out.
+class FixedDecimalEdgeTest : public BaseTest {
+ public:
+  FixedDecimalEdgeTest()
+      : BaseTest({"from_decimal_out_of_range", "to_decimal_max",
+                  "to_decimal_overflow", "to_decimal_negative_overflow"}) {}
+
+ protected:
+  static constexpr Decimal::SignedMantissaType kPowerOf96 =
+      static_cast<Decimal::SignedMantissaType>(1) << 96;
+
+  std::string result_, cmp_result_;
+
+  void printArgs() override {}
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    if (result_ != cmp_result_) {
+      printResults<std::string>(false, result_, cmp_result_);
+      return false;
+    }
+    if (PrintAllResults) {
+      printResults<std::string>(true, result_, cmp_result_);
+    }
+
+    return true;
+  }
+
+  int perform_c() override {
+    if (operation_ == "from_decimal_out_of_range") {
+      cmp_result_ = "0";
+      return Decimal::ConvertationError;
+    } else if (operation_ == "to_decimal_max") {
+      cmp_result_ = "79228162514264337593543950335";
+    } else if (operation_ == "to_decimal_overflow") {
+      cmp_result_ = "0";
+      return Decimal::PositiveOverflowError;
+    } else if (operation_ == "to_decimal_negative_overflow") {
+      cmp_result_ = "0";
+      return Decimal::NegativeOverflowError;
+    }
+
+    return 0;
+  }
+
+  int perform_cpp() override {
+    if (operation_ == "from_decimal_out_of_range") {
+      // 10^11 * 10^28 is above 2^127
+      auto [value, code] = FixedDecimal<28>::fromDecimal("100000000000"_d);
+      result_ = value.toDecimal().toString();
+      return code;
+    }
+
+    Decimal value;
+    if (operation_ == "to_decimal_max") {
+      value = FixedDecimal<0>::fromRaw(kPowerOf96 - 1).toDecimal();
+    } else if (operation_ == "to_decimal_overflow") {
+      value = FixedDecimal<5>::fromRaw(kPowerOf96 * 100000).toDecimal();
+    } else if (operation_ == "to_decimal_negative_overflow") {
+      value = FixedDecimal<0>::fromRaw(-kPowerOf96).toDecimal();
+    }
+    result_ = value.getErrorCode() ? "0" : value.toString();
+
+    return value.getErrorCode();
+  }
+};
+
+}  // namespace s21
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <map>
+
+#include "../decimal/decimal_map.h"
+#include "base_test.h"
+
+namespace s21 {
+
+// Checks that values that compare equal hash equal, through hash() and
+// std::hash, whatever their scale or the sign of zero.
+class HashTest : public BaseTest {
+ public:
+  HashTest(const Decimal& lhs, const Decimal& rhs)
+      : BaseTest({"hash"}), lhs_(lhs), rhs_(rhs) {}
+
+ protected:
+  const Decimal lhs_, rhs_;
+  std::string result_, cmp_result_;
+
+  void printArgs() override {
+    std::cout << "| value_1            | " << std::setw(31) << std::right
+              << lhs_ << " |      |" << std::endl;
+    std::cout << "| value_2            | " << std::setw(31) << std::right
+              << rhs_ << " |      |" << std::endl;
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    if (result_ != cmp_result_) {
+      printResults<std::string>(false, result_, cmp_result_);
+      return false;
+    }
+    if (PrintAllResults) {
+      printResults<std::string>(true, result_, cmp_result_);
+    }
+
+    return true;
+  }
+
+  int perform_c() override {
+    cmp_result_ = lhs_ == rhs_ ? "equal hashes" : "";
+    return 0;
+  }
+
+  int perform_cpp() override {
+    const size_t hash = lhs_.hash();
+    result_ = lhs_ == rhs_ && hash == rhs_.hash() ? "equal hashes" : "";
+    if (std::hash<Decimal>()(lhs_) != hash) result_ = "std::hash differs";
+    return 0;
+  }
+};
+
+// Runs DecimalMap<int> and std::map<Decimal, int>, whose keys are equal
+// when they compare equal, through the same operations and checks the
+// return values, find() of every key and the entries afterwards:
+// "insert" inserts key i with value i, "operator[]" adds i to the value of
+// key i, "erase" inserts all keys and erases every other one and then the
+// rest, "reserve" reserves room for all keys first and inserts them,
+// "clear" inserts all keys, clears and inserts them again. A key with an
+// error throws on insertion and is never found.
+class MapTest : public BaseTest {
+ public:
+  MapTest(const std::vector<Decimal>& keys,
+          const std::vector<std::string>& operations = {
+              "insert", "operator[]", "erase", "reserve", "clear"})
+      : BaseTest(operations), keys_(keys) {}
+
+ protected:
+  const std::vector<Decimal> keys_;
+  std::vector<std::string> result_, cmp_result_;
+
+  void printArgs() override {
+    std::cout << "| keys               | " << std::setw(31) << std::right
+              << keys_.size() << " |      |" << std::endl;
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    for (size_t i = 0; i < cmp_result_.size(); ++i) {
+      if (i >= result_.size() || result_[i] != cmp_result_[i]) {
+        printResults<std::string>(
+            false,
+            "#" + std::to_string(i) + " " +
+                (i < result_.size() ? result_[i] : std::string("missing")),
+            cmp_result_[i]);
+        return false;
+      }
+    }
+    if (PrintAllResults) {
+      printResults<int>(true);
+    }
+
+    return true;
+  }
+
+  // the operations on either map, as the results they give
+  template <typename Map>
+  void apply(Map& map, std::vector<std::string>& out) {
+    auto insertAll = [&] {
+      for (size_t i = 0; i < keys_.size(); ++i) {
+        out.push_back(insert(map, keys_[i], static_cast<int>(i)));
+      }
+    };
+    auto eraseAll = [&](size_t first) {
+      for (size_t i = first; i < keys_.size(); i += 2) {
+        out.push_back(erase(map, keys_[i]) ? "erased" : "missing");
+      }
+    };
+
+    if (operation_ == "insert") {
+      insertAll();
+    } else if (operation_ == "operator[]") {
+      for (size_t i = 0; i < keys_.size(); ++i) {
+        out.push_back(add(map, keys_[i], static_cast<int>(i)));
+      }
+    } else if (operation_ == "erase") {
+      insertAll();
+      eraseAll(0);
+      check(map, out);
+      eraseAll(1);
+    } else if (operation_ == "reserve") {
+      reserve(map, keys_.size());
+      insertAll();
+      reserve(map, 0);
+    } else if (operation_ == "clear") {
+      insertAll();
+      map.clear();
+      check(map, out);
+      insertAll();
+    }
+    check(map, out);
+  }
+
+  // find() of every key, then the entries in key order
+  template <typename Map>
+  void check(const Map& map, std::vector<std::string>& out) {
+    for (const Decimal& key : keys_) {
+      const int* value = find(map, key);
+      out.push_back(value ? std::to_string(*value) : "not found");
+    }
+    std::vector<std::pair<Decimal, int>> entries = this->entries(map);
+    std::stable_sort(
+        entries.begin(), entries.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    out.push_back("size " + std::to_string(entries.size()));
+    for (const auto& [key, value] : entries) {
+      out.push_back(describeUnsignedZero(key) + " = " + std::to_string(value));
+    }
+  }
+
+  static std::string insert(DecimalMap<int>& map, const Decimal& key,
+                            int value) {
+    try {
+      return map.insert(key, value) ? "inserted" : "present";
+    } catch (const std::invalid_argument&) {
+      return "throws";
+    }
+  }
+  static std::string insert(std::map<Decimal, int>& map, const Decimal& key,
+                            int value) {
+    if (key.getErrorCode()) return "throws";
+    return map.emplace(key, value).second ? "inserted" : "present";
+  }
+
+  static std::string add(DecimalMap<int>& map, const Decimal& key,
+                         int value) {
+    try {
+      return std::to_string(map[key] += value);
+    } catch (const std::invalid_argument&) {
+      return "throws";
+    }
+  }
+  static std::string add(std::map<Decimal, int>& map, const Decimal& key,
+                         int value) {
+    if (key.getErrorCode()) return "throws";
+    return std::to_string(map[key] += value);
+  }
+
+  static bool erase(DecimalMap<int>& map, const Decimal& key) {
+    return map.erase(key);
+  }
+  static bool erase(std::map<Decimal, int>& map, const Decimal& key) {
+    return !key.getErrorCode() && map.erase(key) != 0;
+  }
+
+  static const int* find(const DecimalMap<int>& map, const Decimal& key) {
+    if (map.contains(key) != (map.find(key) != nullptr)) {
+      static const int kMismatch = -1;
+      return &kMismatch;
+    }
+    return map.find(key);
+  }
+  static const int* find(const std::map<Decimal, int>& map,
+                         const Decimal& key) {
+    if (key.getErrorCode()) return nullptr;
+    auto it = map.find(key);
+    return it == map.end() ? nullptr : &it->second;
+  }
+
+  static void reserve(DecimalMap<int>& map, size_t count) {
+    map.reserve(count);
+  }
+  static void reserve(std::map<Decimal, int>&, size_t) {}
+
+  static std::vector<std::pair<Decimal, int>> entries(
+      const DecimalMap<int>& map) {
+    std::vector<std::pair<Decimal, int>> result;
+    map.forEach([&result](const Decimal& key, int value) {
+      result.emplace_back(key, value);
+    });
+    if (result.size() != map.size()) result.emplace_back(0L, -1);
+    return result;
+  }
+  static std::vector<std::pair<Decimal, int>> entries(
+      const std::map<Decimal, int>& map) {
+    return {map.begin(), map.end()};
+  }
+
+  int perform_c() override {
+    cmp_result_.clear();
+    std::map<Decimal, int> map;
+    apply(map, cmp_result_);
+    return 0;
+  }
+
+  int perform_cpp() override {
+    result_.clear();
+    DecimalMap<int> map;
+    apply(map, result_);
+    return 0;
+  }
+};
+
+}  // namespace s21
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstring>
+#include <sstream>
+
+#include "../decimal/decimal_batch.h"
+#include "base_test.h"
+
+namespace s21 {
+
+namespace keys {
+
+// std::array compares only at run time before C++20
+constexpr int compare(const Decimal::OrderedKey& lhs,
+                      const Decimal::OrderedKey& rhs) {
+  for (int i = 0; i < Decimal::kOrderedKeySize; ++i) {
+    if (lhs[i] != rhs[i]) return lhs[i] < rhs[i] ? -1 : 1;
+  }
+  return 0;
+}
+
+static_assert(compare("-2"_d.toOrderedKey(), "-1.5"_d.toOrderedKey()) < 0);
+static_assert(compare("-0.001"_d.toOrderedKey(), "0"_d.toOrderedKey()) < 0);
+static_assert(compare("0"_d.toOrderedKey(), "-0"_d.toOrderedKey()) == 0);
+static_assert(compare("1.50"_d.toOrderedKey(), "1.5"_d.toOrderedKey()) == 0);
+static_assert(compare("10"_d.toOrderedKey(), "9.99"_d.toOrderedKey()) > 0);
+static_assert(Decimal::fromOrderedKey("-1.5"_d.toOrderedKey()) == "-1.5"_d);
+static_assert(Decimal::fromOrderedKey(Decimal::OrderedKey{}).getErrorCode() ==
+              Decimal::ConvertationError);
+
+}  // namespace keys
+
+// Checks that the bytes of toOrderedKey() compare with memcmp() as the values
+// do with compare(), errors above all values and by their codes, and that
+// fromOrderedKey() and the DecimalBatch loops give back the normalized
+// values, with the sign of zero dropped.
+class OrderedKeyTest : public BaseTest {
+ public:
+  OrderedKeyTest(const Decimal& lhs, const Decimal& rhs)
+      : BaseTest({"memcmp", "round trip", "batch"}), lhs_(lhs), rhs_(rhs) {}
+
+ protected:
+  const Decimal lhs_, rhs_;
+  std::string result_, cmp_result_;
+
+  static int order(const Decimal& lhs, const Decimal& rhs) {
+    const int lhs_error = lhs.getErrorCode(), rhs_error = rhs.getErrorCode();
+    if (lhs_error || rhs_error) {
+      return lhs_error == rhs_error ? 0 : lhs_error > rhs_error ? 1 : -1;
+    }
+    return lhs.compare(rhs);
+  }
+
+  void printArgs() override {
+    std::cout << "| value_1            | " << std::setw(31) << std::right
+              << lhs_ << " |      |" << std::endl;
+    std::cout << "| value_2            | " << std::setw(31) << std::right
+              << rhs_ << " |      |" << std::endl;
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    if (result_ != cmp_result_) {
+      printResults<std::string>(false, result_, cmp_result_);
+      return false;
+    }
+    if (PrintAllResults) {
+      printResults<std::string>(true, result_, cmp_result_);
+    }
+
+    return true;
+  }
+
+  int perform_c() override {
+    if (operation_ == "memcmp") {
+      cmp_result_ = std::to_string(order(lhs_, rhs_));
+    } else {
+      cmp_result_ =
+          describeUnsignedZero(lhs_) + " " + describeUnsignedZero(rhs_);
+      if (operation_ == "batch") {
+        cmp_result_ += " failed " + std::to_string((lhs_.getErrorCode() != 0) +
+                                                   (rhs_.getErrorCode() != 0));
+      }
+    }
+    return 0;
+  }
+
+  int perform_cpp() override {
+    const Decimal::OrderedKey lhs = lhs_.toOrderedKey();
+    const Decimal::OrderedKey rhs = rhs_.toOrderedKey();
+    if (operation_ == "memcmp") {
+      const int result = std::memcmp(lhs.data(), rhs.data(), lhs.size());
+      result_ = std::to_string(result < 0 ? -1 : result > 0 ? 1 : 0);
+      if ((lhs < rhs) != (result < 0)) result_ += " std::array differs";
+    } else if (operation_ == "round trip") {
+      result_ = describeUnsignedZero(Decimal::fromOrderedKey(lhs)) + " " +
+                describeUnsignedZero(Decimal::fromOrderedKey(rhs));
+    } else if (operation_ == "batch") {
+      const Decimal values[] = {lhs_, rhs_};
+      Decimal::OrderedKey keys[2];
+      Decimal out[2];
+      uint8_t errors[2];
+      DecimalBatch::toOrderedKeys(values, keys, 2);
+      size_t failed = DecimalBatch::fromOrderedKeys(keys, out, 2, errors);
+      result_ = describeUnsignedZero(out[0]) + " " +
+                describeUnsignedZero(out[1]) + " failed " +
+                std::to_string(failed);
+      for (int i = 0; i < 2; ++i) {
+        if (keys[i] != values[i].toOrderedKey() ||
+            errors[i] != out[i].getErrorCode()) {
+          result_ += " #" + std::to_string(i) + " differs";
+        }
+      }
+    }
+    return 0;
+  }
+};
+
+// Decodes arbitrary bytes with fromOrderedKey(): bytes that no value encodes
+// to give ConvertationError, any other bytes the value whose key they are.
+class OrderedKeyBytesTest : public BaseTest {
+ public:
+  // expected, "rejected" or "decoded <value>", is checked if given,
+  // otherwise only the rule above
+  explicit OrderedKeyBytesTest(const Decimal::OrderedKey& key,
+                               const std::string& expected = "")
+      : BaseTest({"fromOrderedKey"}), key_(key), expected_(expected) {}
+
+ protected:
+  const Decimal::OrderedKey key_;
+  const std::string expected_;
+  std::string result_, cmp_result_;
+
+  void printArgs() override {
+    std::ostringstream bytes;
+    for (uint8_t byte : key_) {
+      bytes << std::hex << std::setw(2) << std::setfill('0') << +byte;
+    }
+    std::cout << "| key                | " << std::setw(31) << std::right
+              << bytes.str() << " |      |" << std::endl;
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    if (result_ != cmp_result_) {
+      printResults<std::string>(false, result_, cmp_result_);
+      return false;
+    }
+    if (PrintAllResults) {
+      printResults<std::string>(true, result_, cmp_result_);
+    }
+
+    return true;
+  }
+
+  int perform_c() override {
+    const Decimal value = Decimal::fromOrderedKey(key_);
+    if (!expected_.empty()) {
+      cmp_result_ = expected_;
+    } else if (value.getErrorCode() == Decimal::ConvertationError &&
+               value.toOrderedKey() != key_) {
+      cmp_result_ = "rejected";
+    } else {
+      cmp_result_ = "decoded " + value.toString();
+    }
+    return cmp_result_ == "rejected" ? Decimal::ConvertationError
+                                     : value.getErrorCode();
+  }
+
+  int perform_cpp() override {
+    const Decimal value = Decimal::fromOrderedKey(key_);
+    if (value.toOrderedKey() == key_) {
+      result_ = "decoded " + value.toString();
+    } else if (value.getErrorCode() == Decimal::ConvertationError) {
+      result_ = "rejected";
+    } else {
+      result_ = "decoded " + value.toString() + " to another key";
+    }
+    return value.getErrorCode();
+  }
+};
+
+}  // namespace s21
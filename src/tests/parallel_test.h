@@ -0,0 +1,101 @@
+#pragma once
+
+#include "../decimal/decimal_accumulator.h"
+#include "../decimal/decimal_parallel.h"
+#include "base_test.h"
+
+namespace s21 {
+
+// Runs every DecimalParallel reduction with 1, 2, 3 and the hardware number
+// of threads and checks each result against one sequential loop: sums with
+// DecimalAccumulator, the first of the smallest or largest values, and the
+// first error in index order.
+class ParallelTest : public BaseTest {
+ public:
+  ParallelTest(const std::vector<Decimal>& lhs, const std::vector<Decimal>& rhs)
+      : BaseTest({"sum", "min", "max", "dot"}), lhs_(lhs), rhs_(rhs) {}
+
+ protected:
+  static constexpr unsigned kThreads[] = {1, 2, 3, 0};
+
+  const std::vector<Decimal> lhs_, rhs_;
+  std::vector<std::string> result_, cmp_result_;
+
+  // equal values of the minimum or maximum differ in the sign of zero
+  void printArgs() override {
+    printSize(lhs_.size());
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    for (size_t i = 0; i < cmp_result_.size(); ++i) {
+      if (result_[i] != cmp_result_[i]) {
+        printResults<std::string>(false, result_[i], cmp_result_[i]);
+        return false;
+      }
+    }
+    if (PrintAllResults) {
+      printResults<int>(true);
+    }
+
+    return true;
+  }
+
+  int perform_c() override {
+    Decimal result;
+    if (operation_ == "sum" || operation_ == "dot") {
+      DecimalAccumulator sum;
+      for (size_t i = 0; i < lhs_.size(); ++i) {
+        sum += operation_ == "sum" ? lhs_[i] : lhs_[i] * rhs_[i];
+      }
+      result = sum.result();
+    } else {
+      for (size_t i = 0; i < lhs_.size(); ++i) {
+        const Decimal& value = lhs_[i];
+        if (value.getErrorCode()) {
+          result = value;
+          break;
+        }
+        if (i == 0 || (operation_ == "min" ? value < result : value > result)) {
+          result = value;
+        }
+      }
+    }
+
+    cmp_result_.clear();
+    for (unsigned threads : kThreads) {
+      cmp_result_.push_back(std::to_string(threads) + " threads: " +
+                            describe(result));
+    }
+
+    return result.getErrorCode();
+  }
+
+  int perform_cpp() override {
+    result_.clear();
+    int code = 0;
+    for (unsigned threads : kThreads) {
+      Decimal result;
+      const size_t size = lhs_.size();
+      if (operation_ == "sum") {
+        result = DecimalParallel::sum(lhs_.data(), size, threads);
+      } else if (operation_ == "min") {
+        result = DecimalParallel::min(lhs_.data(), size, threads);
+      } else if (operation_ == "max") {
+        result = DecimalParallel::max(lhs_.data(), size, threads);
+      } else if (operation_ == "dot") {
+        result = DecimalParallel::dot(lhs_.data(), rhs_.data(), size, threads);
+      }
+      result_.push_back(std::to_string(threads) + " threads: " +
+                        describe(result));
+      code = result.getErrorCode();
+    }
+
+    return code;
+  }
+};
+
+}  // namespace s21
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "../decimal/decimal_parser.h"
+#include "base_test.h"
+
+namespace s21 {
+
+// Parses a column with every DecimalParser kernel and checks each field
+// against from_chars on that field alone. A kernel the CPU lacks falls back
+// to the scalar one.
+class ParserTest : public BaseTest {
+ public:
+  ParserTest(const std::string& text, char delimiter = ',',
+             const std::vector<std::string>& operations = {"scalar", "sse4.2",
+                                                           "avx2"})
+      : BaseTest(operations), text_(text), delimiter_(delimiter) {}
+
+ protected:
+  const std::string text_;
+  const char delimiter_;
+  std::vector<std::string> result_, cmp_result_;
+
+  void printArgs() override {
+    std::cout << "| text               | " << std::setw(31) << std::right
+              << text_ << " |      |" << std::endl;
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    for (size_t i = 0; i < cmp_result_.size(); ++i) {
+      if (result_[i] != cmp_result_[i]) {
+        printResults<std::string>(false, "#" + std::to_string(i) + " " +
+                                             result_[i],
+                                  cmp_result_[i]);
+        return false;
+      }
+    }
+    if (PrintAllResults) {
+      printResults<int>(true);
+    }
+
+    return true;
+  }
+
+  // fields end at the delimiter or a newline, and one at the very end of
+  // the text does not start another field
+  int perform_c() override {
+    cmp_result_.clear();
+    size_t begin = 0;
+    while (begin < text_.size()) {
+      size_t end = text_.find_first_of(std::string{delimiter_, '\n'}, begin);
+      if (end == std::string::npos) end = text_.size();
+
+      Decimal value;
+      const char* first = text_.data() + begin;
+      const char* last = text_.data() + end;
+      auto [ptr, ec] = from_chars(first, last, value);
+      if (ec == std::errc::invalid_argument || ptr != last) {
+        cmp_result_.push_back("error " +
+                              std::to_string(Decimal::ConvertationError));
+      } else {
+        cmp_result_.push_back(describe(value));
+      }
+      begin = end + 1;
+    }
+
+    return static_cast<int>(cmp_result_.size());
+  }
+
+  int perform_cpp() override {
+    DecimalParser::Kernel kernel = DecimalParser::Scalar;
+    if (operation_ == "sse4.2") {
+      kernel = DecimalParser::Sse42;
+    } else if (operation_ == "avx2") {
+      kernel = DecimalParser::Avx2;
+    }
+
+    std::vector<Decimal> values(text_.size() + 1);
+    const char* last = text_.data() + text_.size();
+    auto [count, ptr] = DecimalParser::parse(
+        kernel, text_.data(), last, delimiter_, values.data(), values.size());
+    if (ptr != last) {
+      return -1;
+    }
+    result_.clear();
+    for (size_t i = 0; i < count; ++i) {
+      result_.push_back(describe(values[i]));
+    }
+
+    return static_cast<int>(count);
+  }
+};
+
+}  // namespace s21
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <thread>
+
+#include "../decimal/decimal_parser.h"
+#include "../decimal/decimal_reader.h"
+#include "base_test.h"
+
+namespace s21 {
+
+// Reads text with DecimalReader and checks the values and error indices
+// against DecimalParser::parse() on the whole text: "file" from a file,
+// "pipe" from a pipe written a few bytes at a time. "open pipe" writes the
+// text to a pipe and keeps it open: every field followed by a separator must
+// be read without waiting for more input, and destroying the reader must
+// not wait for the writer either.
+class ReaderTest : public BaseTest {
+ public:
+  ReaderTest(const std::string& text, size_t block_size = 40)
+      : BaseTest({"file", "pipe", "open pipe"}),
+        text_(text),
+        block_size_(block_size) {}
+
+ protected:
+  static constexpr size_t kChunk = 5;
+  static constexpr size_t kCapacity = 3;
+  static constexpr auto kTimeout = std::chrono::seconds(5);
+
+  const std::string text_;
+  const size_t block_size_;
+  std::vector<std::string> result_, cmp_result_;
+
+  void printArgs() override {
+    std::cout << "| text               | " << std::setw(31) << std::right
+              << text_.substr(0, 31) << " |      |" << std::endl;
+    std::cout << "| block size         | " << std::setw(31) << std::right
+              << block_size_ << " |      |" << std::endl;
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    for (size_t i = 0; i < cmp_result_.size(); ++i) {
+      if (i >= result_.size() || result_[i] != cmp_result_[i]) {
+        printResults<std::string>(
+            false,
+            "#" + std::to_string(i) + " " +
+                (i < result_.size() ? result_[i] : std::string("missing")),
+            cmp_result_[i]);
+        return false;
+      }
+    }
+    if (PrintAllResults) {
+      printResults<int>(true);
+    }
+
+    return true;
+  }
+
+  // The values of text, then the indices of those with an error; fields
+  // longer than a block are ConvertationError.
+  void parse(const std::string& text, std::vector<std::string>& out) {
+    std::vector<Decimal> values(text.size() + 1);
+    const size_t count =
+        DecimalParser::parse(text, ',', values.data(), values.size()).count;
+    std::string errors = "errors";
+    size_t first = 0;
+    for (size_t i = 0; i < count; ++i) {
+      const size_t last = std::min(text.find_first_of(",\n", first),
+                                   text.size());
+      if (last - first > block_size_) {
+        out.push_back("error " + std::to_string(Decimal::ConvertationError));
+      } else {
+        out.push_back(describe(values[i]));
+      }
+      if (last - first > block_size_ || values[i].getErrorCode()) {
+        errors += " " + std::to_string(i);
+      }
+      first = last + 1;
+    }
+    out.push_back(errors);
+  }
+
+  // reads up to count values, or all of them, kCapacity at a time
+  static void read(DecimalReader& reader, std::vector<std::string>& out,
+                   size_t count = static_cast<size_t>(-1)) {
+    Decimal values[kCapacity];
+    std::vector<size_t> indices;
+    std::string errors = "errors";
+    while (count > 0) {
+      const size_t read = reader.read(values, std::min(count, kCapacity),
+                                      &indices);
+      if (read == 0) break;
+      for (size_t i = 0; i < read; ++i) out.push_back(describe(values[i]));
+      count -= read;
+    }
+    for (size_t index : indices) errors += " " + std::to_string(index);
+    out.push_back(errors);
+  }
+
+  int perform_c() override {
+    cmp_result_.clear();
+    if (operation_ == "open pipe") {
+      // the fields before the last separator
+      parse(text_.substr(0, text_.find_last_of(",\n") + 1), cmp_result_);
+      cmp_result_.push_back("destroyed");
+    } else {
+      parse(text_, cmp_result_);
+    }
+    return 0;
+  }
+
+  int perform_cpp() override {
+    result_.clear();
+    if (operation_ == "file") {
+      char directory[] = "/tmp/s21_reader_test.XXXXXX";
+      if (!::mkdtemp(directory)) return -1;
+      const std::string path = std::string(directory) + "/values.csv";
+      std::ofstream(path, std::ios::binary) << text_;
+      {
+        DecimalReader reader(path, ',', block_size_, 2);
+        read(reader, result_);
+      }
+      std::filesystem::remove_all(directory);
+      return 0;
+    }
+
+    int fds[2];
+    if (::pipe(fds) != 0) return -1;
+    if (operation_ == "pipe") {
+      std::thread writer([this, fd = fds[1]] {
+        for (size_t i = 0; i < text_.size(); i += kChunk) {
+          const size_t size = std::min(kChunk, text_.size() - i);
+          if (::write(fd, text_.data() + i, size) < 0) break;
+        }
+        ::close(fd);
+      });
+      {
+        DecimalReader reader(fds[0], ',', block_size_, 2);
+        read(reader, result_);
+      }
+      writer.join();
+      ::close(fds[0]);
+      return 0;
+    }
+
+    // the pipe holds the whole text, the writer stays open
+    const size_t complete = text_.find_last_of(",\n") + 1;
+    size_t expected = 0;
+    if (complete != 0) {
+      std::vector<Decimal> values(complete + 1);
+      expected = DecimalParser::parse(text_.substr(0, complete), ',',
+                                      values.data(), values.size())
+                     .count;
+    }
+    if (::write(fds[1], text_.data(), text_.size()) < 0) return -1;
+    auto reading = std::async(std::launch::async, [&] {
+      std::vector<std::string> out;
+      {
+        DecimalReader reader(fds[0], ',', block_size_, 2);
+        read(reader, out, expected);
+      }
+      out.push_back("destroyed");
+      return out;
+    });
+    if (reading.wait_for(kTimeout) == std::future_status::timeout) {
+      // the end of the input lets a reader that waits for it finish
+      ::close(fds[1]);
+      fds[1] = -1;
+      result_ = reading.get();
+      result_.back() = "hangs";
+    } else {
+      result_ = reading.get();
+    }
+    if (fds[1] >= 0) ::close(fds[1]);
+    ::close(fds[0]);
+    return 0;
+  }
+};
+
+}  // namespace s21
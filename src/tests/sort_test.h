@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+
+#include "../decimal/decimal_sort.h"
+#include "base_test.h"
+
+namespace s21 {
+
+// Runs DecimalSort::sort and argsort with 1, 2, 3 and the hardware number of
+// threads and checks both against std::stable_sort by compare(), with the
+// values that have an error last, by error code. The sign of zero and the
+// indices show the order of equal values.
+class SortTest : public BaseTest {
+ public:
+  explicit SortTest(const std::vector<Decimal>& values)
+      : BaseTest({"sort", "argsort"}), values_(values) {}
+
+ protected:
+  static constexpr unsigned kThreads[] = {1, 2, 3, 0};
+
+  const std::vector<Decimal> values_;
+  std::vector<std::string> result_, cmp_result_;
+
+  void printArgs() override {
+    printSize(values_.size());
+  }
+
+  bool checking() override {
+    if (!checkingCode()) {
+      return false;
+    }
+
+    for (size_t i = 0; i < cmp_result_.size(); ++i) {
+      if (result_[i] != cmp_result_[i]) {
+        printResults<std::string>(false, "#" + std::to_string(i) + " " +
+                                             result_[i], cmp_result_[i]);
+        return false;
+      }
+    }
+    if (PrintAllResults) {
+      printResults<int>(true);
+    }
+
+    return true;
+  }
+
+  // the sorted values, or the indices of the sorted values
+  void append(const std::vector<Decimal>& sorted,
+              const std::vector<size_t>& indices, unsigned threads,
+              std::vector<std::string>& out) {
+    const std::string prefix = std::to_string(threads) + " threads: ";
+    for (size_t i = 0; i < values_.size(); ++i) {
+      out.push_back(prefix + (operation_ == "sort"
+                                  ? describe(sorted[i])
+                                  : std::to_string(indices[i])));
+    }
+  }
+
+  int perform_c() override {
+    std::vector<size_t> indices(values_.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    std::stable_sort(
+        indices.begin(), indices.end(), [this](size_t lhs, size_t rhs) {
+          const int lhs_error = values_[lhs].getErrorCode();
+          const int rhs_error = values_[rhs].getErrorCode();
+          if (lhs_error || rhs_error) {
+            return lhs_error == 0 || (rhs_error != 0 && lhs_error < rhs_error);
+          }
+          return values_[lhs] < values_[rhs];
+        });
+    std::vector<Decimal> sorted;
+    for (size_t index : indices) sorted.push_back(values_[index]);
+
+    cmp_result_.clear();
+    for (unsigned threads : kThreads) {
+      append(sorted, indices, threads, cmp_result_);
+    }
+
+    return 0;
+  }
+
+  int perform_cpp() override {
+    result_.clear();
+    for (unsigned threads : kThreads) {
+      std::vector<Decimal> sorted(values_);
+      std::vector<size_t> indices(values_.size());
+      if (operation_ == "sort") {
+        DecimalSort::sort(sorted.data(), sorted.size(), threads);
+      } else {
+        DecimalSort::argsort(values_.data(), values_.size(), indices.data(),
+                             threads);
+      }
+      append(sorted, indices, threads, result_);
+    }
+
+    return 0;
+  }
+};
+
+}  // namespace s21
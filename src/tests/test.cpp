@@ -1,7 +1,22 @@
+#include <limits>
+
+#include "accumulator_test.h"
 #include "arithmetic_test.h"
+#include "batch_test.h"
+#include "codec_test.h"
+#include "chars_test.h"
+#include "column_test.h"
 #include "comparison_test.h"
 #include "convertors_test.h"
+#include "file_test.h"
+#include "fixed_decimal_test.h"
+#include "map_test.h"
+#include "ordered_key_test.h"
 #include "other_test.h"
+#include "parallel_test.h"
+#include "parser_test.h"
+#include "reader_test.h"
+#include "sort_test.h"
 
 using namespace s21;
 
@@ -31,6 +46,369 @@ int main() try {
   run_test<ComparisonTest>("792281625142643.37593543950335"_d,
                            "453435434.434343"_d, "!=");
 
+  const Decimal max = "79228162514264337593543950335"_d;
+
+  run_test<FromCharsTest>("0.00000000000000000000000000015",
+                          "0.0000000000000000000000000002"_d);
+
+  run_test<FromCharsTest>("0.00000000000000000000000000025",
+                          "0.0000000000000000000000000002"_d);
+
+  run_test<FromCharsTest>("0.000000000000000000000000000250001",
+                          "0.0000000000000000000000000003"_d);
+
+  run_test<FromCharsTest>("7.92281625142643375935439503355",
+                          "7.922816251426433759354395034"_d);
+
+  run_test<FromCharsTest>("79228162514264337593543950335.49", max);
+
+  run_test<FromCharsTest>("79228162514264337593543950335.5", max + 1L,
+                          std::errc::result_out_of_range);
+
+  run_test<FromCharsTest>("79228162514264337593543950336", max + 1L,
+                          std::errc::result_out_of_range);
+
+  run_test<FromCharsTest>("-79228162514264337593543950336", -max - 1L,
+                          std::errc::result_out_of_range);
+
+  run_test<FromCharsTest>("", FromCharsTest::kInitial,
+                          std::errc::invalid_argument, 0);
+
+  run_test<FromCharsTest>("-.x", FromCharsTest::kInitial,
+                          std::errc::invalid_argument, 0);
+
+  run_test<FromCharsTest>("+.5", "0.5"_d);
+
+  run_test<FromCharsTest>("12.50x", "12.5"_d, std::errc(), 5);
+
+  run_test<ToCharsTest>("-0.0000000000000000000000000001"_d, 0);
+
+  run_test<ToCharsTest>("-0.0000000000000000000000000001"_d, 31);
+
+  run_test<ToCharsTest>("-0.0000000000000000000000000001"_d, 30);
+
+  run_test<ParserTest>(
+      "1.5,-2,abc,,0.0000000000000000000000000001,-0,1.50,12x,"
+      "79228162514264337593543950336,-79228162514264337593543950335,");
+
+  run_test<ParserTest>(
+      "1234567890.12345678901234567890123456789,"
+      "-0.000000000000000000000000000000000001,"
+      "7.92281625142643375935439503355,00000000000000000000000000000000001");
+
+  run_test<ParserTest>("1;2.50\n-3;+.5\n;x;100000000000000000000000000;4\n",
+                       ';');
+
+  run_test<ParserTest>("");
+
+  run_test<FromDoubleTest>(0.1, "0.1");
+
+  run_test<FromDoubleTest>(1.0 / 3, "0.333333333333333");
+
+  run_test<FromDoubleTest>(123456789.123456789, "123456789.123457");
+
+  run_test<FromDoubleTest>(-0.0, "-0");
+
+  run_test<FromDoubleTest>(2.5e-28, "0.0000000000000000000000000003");
+
+  run_test<FromDoubleTest>(2.5e-29, "error 4");
+
+  run_test<FromDoubleTest>(7.92281625142643e28,
+                           "79228162514264300000000000000");
+
+  run_test<FromDoubleTest>(7.92281625142644e28, "error 1");
+
+  run_test<FromDoubleTest>(-1e300, "error 2");
+
+  run_test<FromDoubleTest>(std::numeric_limits<double>::infinity(),
+                           "invalid_argument");
+
+  run_test<FromDoubleTest>(std::numeric_limits<double>::quiet_NaN(),
+                           "invalid_argument");
+
+  run_test<ToDoubleTest>("7.9228162514264337593543950335"_d,
+                         "from_decimal_to_double");
+
+  run_test<ToDoubleTest>("-453435434.434343"_d);
+
+  run_test<FixedDecimalTest<2>>("0.05"_d, "0.5"_d);
+
+  run_test<FixedDecimalTest<2>>("-0.15"_d, "0.5"_d);
+
+  run_test<FixedDecimalTest<2>>("0.35"_d, "-1.01"_d);
+
+  run_test<FixedDecimalTest<2>>("1.005"_d, "1"_d);
+
+  run_test<FixedDecimalEdgeTest>();
+
+  run_test<CheckedTest>(max, "0.5"_d);
+
+  run_test<CheckedTest>(max, "0.4"_d);
+
+  run_test<CheckedTest>(-max, "1.0000000000000000000000000001"_d);
+
+  run_test<CheckedTest>("0.0000000000000000000000000001"_d, 3L);
+
+  run_test<CheckedTest>(1L, "-0"_d);
+
+  run_test<CheckedTest>(max + 1L, 0L);
+
+  run_test<CheckedTest>(1L, "1"_d / 0L);
+
+  // a * b leaves 96 bits, a * b + c does not
+  run_test<FmaTest>(max, 2L, -max);
+
+  run_test<FmaTest>(-max, "1.5"_d, "39614081257132168796771975167.5"_d);
+
+  run_test<FmaTest>("0.0000000000000000000000000001"_d,
+                    "0.0000000000000000000000000001"_d,
+                    "0.0000000000000000000000000001"_d);
+
+  // rounded once: the product alone would round to 2.5e-28, half to even
+  run_test<FmaTest>("0.0000000000000000000000000025"_d, "0.99"_d,
+                    "0.00000000000000000000000000001"_d);
+
+  run_test<FmaTest>("1.0000000000000000000000000001"_d,
+                    "1.0000000000000000000000000001"_d, -1L);
+
+  run_test<FmaTest>(max, 2L, -1L);
+
+  // the first operand error wins, also over an overflow of a * b
+  run_test<FmaTest>(max + 1L, -max - 1L, "1"_d / 0L);
+
+  run_test<FmaTest>(1L, -max - 1L, "1"_d / 0L);
+
+  run_test<FmaTest>(max, 2L, "1"_d / 0L);
+
+  run_test<FmaTest>(max, max, -max - 1L);
+
+  run_test<BatchTest>(
+      std::vector<Decimal>{max, -max, "0.5"_d, "-2.5"_d, "1.5"_d, 0L,
+                           "-0.0000000000000000000000000001"_d, max + 1L,
+                           "3"_d, "-7.9228162514264337593543950335"_d},
+      std::vector<Decimal>{"1"_d, "-1"_d, 0L, "0.5"_d,
+                           "0.0000000000000000000000000001"_d, max,
+                           "-0.5"_d, "2"_d, -max - 1L, "0.3"_d});
+
+  // blocks of 256 values of one scale take the rounding kernels; an error
+  // in the middle of one block sends it to the scalar loop
+  std::vector<Decimal> money, ticks, wide;
+  for (long i = 0; i < 1000; ++i) {
+    money.push_back(Decimal(10 * i - 4995) * "0.001"_d);
+    ticks.push_back(Decimal(2 * i + 1) * "0.0000000000000000000000000001"_d);
+    wide.push_back(Decimal(2 * i - 999) * "1234567890.123456789012345679"_d);
+  }
+  money[300] = max + 1L;
+
+  run_test<BatchTest>(money, ticks);
+
+  run_test<BatchTest>(wide, money, BatchTest::InPlace);
+
+  run_test<BatchTest>(ticks, wide, BatchTest::Broadcast);
+
+  // past 96 bits and back
+  run_test<AccumulatorTest>(std::vector<Decimal>{max, max, "0.5"_d, -max});
+
+  // one rounding at the end, half to even: ...335.5 overflows, ...334.5 not
+  run_test<AccumulatorTest>(std::vector<Decimal>{max, "0.25"_d, "0.25"_d});
+
+  run_test<AccumulatorTest>(std::vector<Decimal>{max - 1L, "0.5"_d});
+
+  run_test<AccumulatorTest>(
+      std::vector<Decimal>{"7.9228162514264337593543950335"_d,
+                           "0.0000000000000000000000000001"_d});
+
+  run_test<AccumulatorTest>(std::vector<Decimal>{
+      "0.0000000000000000000000000001"_d, -max, -max, "-0"_d, max});
+
+  // the first error wins, also across merge()
+  run_test<AccumulatorTest>(
+      std::vector<Decimal>{1L, "0.1"_d / 0L, max + 1L, -max - 1L});
+
+  run_test<AccumulatorTest>(std::vector<Decimal>{1L, 2L, -max - 1L, max + 1L});
+
+  run_test<AccumulatorTest>(std::vector<Decimal>{});
+
+  run_test<AccumulatorTest>(money);
+
+  run_test<AccumulatorTest>(ticks);
+
+  run_test<AccumulatorTest>(wide);
+
+  // three parts of more than kMinPart values
+  const size_t large = 3 * DecimalParallel::kMinPart + 7;
+  std::vector<Decimal> prices, quantities;
+  for (size_t i = 0; i < large; ++i) {
+    prices.push_back(Decimal(static_cast<long>(i % 1999) - 999) * "0.01"_d);
+    quantities.push_back(wide[i % wide.size()] / 7L);
+  }
+  run_test<ParallelTest>(prices, quantities);
+
+  // the first of equal values wins, whichever part it is in
+  std::vector<Decimal> ties(large, 1L);
+  ties[70000] = "-0"_d;
+  ties[150000] = "0"_d;
+  run_test<ParallelTest>(ties, prices);
+  std::swap(ties[70000], ties[150000]);
+  run_test<ParallelTest>(ties, prices);
+
+  // the first error in index order wins, whichever part it is in
+  std::vector<Decimal> failing(prices);
+  failing[150000] = max + 1L;
+  run_test<ParallelTest>(failing, quantities);
+  failing[100000] = -max - 1L;
+  run_test<ParallelTest>(failing, quantities);
+  quantities[70000] = "1"_d / 0L;
+  run_test<ParallelTest>(failing, quantities);
+
+  run_test<SortTest>(std::vector<Decimal>{});
+
+  // equal values keep their order: 0 and -0, 1 and 1.00, errors of one code
+  run_test<SortTest>(std::vector<Decimal>{
+      1L, "-0"_d, "1.00"_d, "0"_d, max + 1L, -max, "1"_d / 0L, -max - 1L,
+      "0.5"_d, max + 1L, "-0.50"_d, "0.000"_d, "-0.5"_d, max, "1.0"_d});
+
+  run_test<SortTest>(money);
+
+  // either side of the smallest size that takes the radix sort, 4096
+  std::vector<Decimal> mixed;
+  for (size_t i = 0; i < 4096; ++i) {
+    mixed.push_back(i % 7 == 0 ? money[i % money.size()] : wide[i % 1000]);
+  }
+  mixed[10] = "-0"_d;
+  mixed[3000] = "0.00"_d;
+  mixed[4000] = "1"_d / 0L;
+  run_test<SortTest>(std::vector<Decimal>(mixed.begin(), mixed.end() - 1));
+  run_test<SortTest>(mixed);
+
+  // one part and more than one, with values and errors in all of them
+  run_test<SortTest>(std::vector<Decimal>(
+      failing.begin(), failing.begin() + DecimalParallel::kMinPart + 1));
+  run_test<SortTest>(failing);
+  run_test<SortTest>(ties);
+  run_test<SortTest>(quantities);
+
+  // -0, errors and values with more fractional digits than the stream scale
+  // or too large once raised are escaped to the plain form
+  const std::vector<Decimal> escapes = {
+      "1.5"_d,   "-0"_d,     max,       "-1.25"_d, "0.001"_d, max + 1L,
+      "-2.5"_d,  "1"_d / 0L, "0"_d,     -max,      -max - 1L, "-0.01"_d,
+      "99.99"_d, "1.5"_d,    "-1.50"_d, "7922816251426433759354395033.5"_d};
+  for (auto mode : {DecimalEncoder::CommonScale, DecimalEncoder::Delta}) {
+    run_test<CodecTest>(std::vector<Decimal>{}, mode, 2);
+    run_test<CodecTest>(escapes, mode, 0);
+    run_test<CodecTest>(escapes, mode, 2);
+    run_test<CodecTest>(escapes, mode, 28);
+    run_test<CodecTest>(money, mode, 3);
+    run_test<CodecTest>(ticks, mode, 28);
+    run_test<CodecTest>(wide, mode, 18);
+  }
+  run_test<CodecTest>(std::vector<Decimal>{}, DecimalEncoder::Plain);
+  run_test<CodecTest>(escapes, DecimalEncoder::Plain);
+  run_test<CodecTest>(money, DecimalEncoder::Plain);
+  run_test<CodecTest>(wide, DecimalEncoder::Plain);
+
+  run_test<FileTest>(std::vector<Decimal>{});
+  run_test<FileTest>(escapes);
+  // more than one chunk of 4096 values
+  run_test<FileTest>(mixed);
+  run_test<FileTest>(std::vector<Decimal>(mixed.begin(), mixed.end() - 1));
+
+  run_test<ReaderTest>("");
+  // the pipe holds complete fields only while the writer waits
+  run_test<ReaderTest>("1,2,");
+  run_test<ReaderTest>("1,2");
+  run_test<ReaderTest>("-0.5\n79228162514264337593543950335,x,,1.5e3,"
+                       "79228162514264337593543950336\n0.000");
+  // fields split across blocks, and one longer than a block
+  run_test<ReaderTest>("1234.5678,-9.25,3,4,0.0000000000000000000000000001,"
+                       "7,8,9,10,11,12,13,14,15,16,17,18,19,20,",
+                       12);
+
+  run_test<ColumnTest>(std::vector<Decimal>{});
+
+  // max leaves no room for a fractional digit until it is replaced
+  run_test<ColumnTest>(std::vector<Decimal>{max, 1L}, 0,
+                       std::vector<Decimal>{"0.5"_d});
+
+  run_test<ColumnTest>(std::vector<Decimal>{"1.5"_d, max, "-2"_d});
+
+  run_test<ColumnTest>(std::vector<Decimal>{1L, "-7.5"_d, max + 1L,
+                                            "0.0000000000000000000000000001"_d,
+                                            -max - 1L, "-0"_d},
+                       28, std::vector<Decimal>{"8"_d});
+
+  // signs in more than one word, then an error in the middle
+  std::vector<Decimal> column(money.begin(), money.begin() + 200);
+  run_test<ColumnTest>(column, 3);
+  column[150] = max + 1L;
+  run_test<ColumnTest>(column);
+
+  run_test<HashTest>(Decimal({100, 0, 0, 2 << 16}), 1L);
+  run_test<HashTest>(Decimal({0, 0, 0, 0x80000000}), "0"_d);
+  run_test<HashTest>("-0.000"_d, "0.0"_d);
+  run_test<HashTest>("1.000"_d, "1"_d);
+  run_test<HashTest>("0.5"_d * 2L, "1.0"_d);
+  run_test<HashTest>("2.50"_d - "0.5"_d, 2L);
+  run_test<HashTest>(max / 10L, "7922816251426433759354395033.5"_d);
+
+  run_test<OrderedKeyTest>("1.5"_d, "1.50"_d);
+  run_test<OrderedKeyTest>("-0"_d, "0.000"_d);
+  run_test<OrderedKeyTest>("-2"_d, "-1.5"_d);
+  run_test<OrderedKeyTest>("10"_d, "9.999"_d);
+  run_test<OrderedKeyTest>("0.1"_d, "0.0999999999999999999999999999"_d);
+  run_test<OrderedKeyTest>("-0.1"_d, "-0.0999999999999999999999999999"_d);
+  run_test<OrderedKeyTest>("0.0000000000000000000000000001"_d, "-0"_d);
+  run_test<OrderedKeyTest>("-0.0000000000000000000000000001"_d, "0"_d);
+  run_test<OrderedKeyTest>(max, -max);
+  run_test<OrderedKeyTest>(max, "7922816251426433759354395033.5"_d);
+  run_test<OrderedKeyTest>(max + 1L, max);
+  run_test<OrderedKeyTest>(-max - 1L, max + 1L);
+  run_test<OrderedKeyTest>("1"_d / 0L, -max);
+
+  // keys encoded at compile time decode at run time and encode back the same
+  constexpr Decimal::OrderedKey kNegativeKey = "-1.5"_d.toOrderedKey();
+  constexpr Decimal::OrderedKey kTinyKey =
+      "0.0000000000000000000000000001"_d.toOrderedKey();
+  constexpr Decimal::OrderedKey kMaxKey =
+      "-79228162514264337593543950335"_d.toOrderedKey();
+  run_test<OrderedKeyBytesTest>(kNegativeKey, "decoded -1.5");
+  run_test<OrderedKeyBytesTest>(kTinyKey,
+                                "decoded 0.0000000000000000000000000001");
+  run_test<OrderedKeyBytesTest>(kMaxKey,
+                                "decoded -79228162514264337593543950335");
+  run_test<OrderedKeyBytesTest>((max + 1L).toOrderedKey());
+
+  // bytes that no value encodes to
+  Decimal::OrderedKey key{};
+  run_test<OrderedKeyBytesTest>(key, "rejected");
+  key.fill(0xFF);
+  run_test<OrderedKeyBytesTest>(key, "rejected");
+  key = "1"_d.toOrderedKey();
+  key[15] ^= 1;  // one trailing zero more than the digits have
+  run_test<OrderedKeyBytesTest>(key, "rejected");
+  key = "1"_d.toOrderedKey();
+  key[1] ^= 0x80;  // a digit below the first one
+  run_test<OrderedKeyBytesTest>(key, "rejected");
+  key = (max + 1L).toOrderedKey();
+  key[15] = key[14] = 0;  // an error key without a code
+  run_test<OrderedKeyBytesTest>(key, "rejected");
+  key = "-1"_d.toOrderedKey();
+  key[0] ^= 0x7F;  // a negative exponent beyond any scale
+  run_test<OrderedKeyBytesTest>(key, "rejected");
+
+  run_test<MapTest>(std::vector<Decimal>{});
+
+  // scales and the sign of zero do not make keys distinct
+  run_test<MapTest>(std::vector<Decimal>{
+      "1"_d, "1.00"_d, "-0"_d, "0.000"_d, max, -max, max + 1L, "1.0"_d, "-1"_d,
+      "0.0000000000000000000000000001"_d});
+
+  // clusters long enough for erase() to shift entries back across the end
+  // of the table, and growth past several capacities
+  run_test<MapTest>(money);
+  run_test<MapTest>(std::vector<Decimal>(wide.begin(), wide.begin() + 100));
+
   general_results();
 
 } catch (const std::exception& e) {
@@ -1,7 +1,22 @@
+#include <algorithm>
+
+#include "accumulator_test.h"
 #include "arithmetic_test.h"
+#include "batch_test.h"
+#include "codec_test.h"
+#include "chars_test.h"
+#include "column_test.h"
 #include "comparison_test.h"
 #include "convertors_test.h"
+#include "file_test.h"
+#include "fixed_decimal_test.h"
+#include "map_test.h"
+#include "ordered_key_test.h"
 #include "other_test.h"
+#include "parallel_test.h"
+#include "parser_test.h"
+#include "reader_test.h"
+#include "sort_test.h"
 
 using namespace s21;
 
@@ -11,7 +26,186 @@ void loop_test_decimal(const Decimal arr[], size_t size) {
     run_test<FromDecimalTest>(arr[i]);
     for (size_t j = 0; j < size; ++j) {
       run_test<ArithmeticTest>(arr[i], arr[j]);
+      run_test<CheckedTest>(arr[i], arr[j]);
       run_test<ComparisonTest>(arr[i], arr[j]);
+      run_test<HashTest>(arr[i], arr[j]);
+      run_test<HashTest>(arr[i] * arr[j], arr[j] * arr[i]);
+      run_test<OrderedKeyTest>(arr[i], arr[j]);
+      run_test<OrderedKeyTest>(arr[i] * arr[j], arr[i] / arr[j]);
+      run_test<FixedDecimalTest<1>>(arr[i], arr[j]);
+      run_test<FixedDecimalTest<4>>(arr[i], arr[j]);
+    }
+  }
+}
+
+void loop_test_accumulator(const Decimal arr[], size_t size) {
+  run_test<AccumulatorTest>(std::vector<Decimal>(arr, arr + size));
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      run_test<AccumulatorTest>(std::vector<Decimal>{arr[i], arr[j], -arr[i]});
+    }
+  }
+}
+
+void loop_test_batch(const Decimal arr[], size_t size) {
+  std::vector<Decimal> lhs, rhs;
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      lhs.push_back(arr[i]);
+      rhs.push_back(arr[j]);
+    }
+  }
+  run_test<BatchTest>(lhs, rhs);
+  run_test<BatchTest>(lhs, rhs, BatchTest::InPlace);
+
+  std::vector<Decimal> column(arr, arr + size);
+  for (size_t j = 0; j < size; ++j) {
+    std::vector<Decimal> broadcast(column);
+    std::rotate(broadcast.begin(), broadcast.begin() + j, broadcast.end());
+    run_test<BatchTest>(column, broadcast, BatchTest::Broadcast);
+  }
+}
+
+void loop_test_codec(const Decimal arr[], size_t size) {
+  std::vector<Decimal> values;
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      values.push_back(arr[i] * arr[j]);
+      values.push_back(arr[i] / arr[j]);
+    }
+  }
+  run_test<CodecTest>(values, DecimalEncoder::Plain);
+  for (int scale : {0, 5, 28}) {
+    run_test<CodecTest>(values, DecimalEncoder::CommonScale, scale);
+    run_test<CodecTest>(values, DecimalEncoder::Delta, scale);
+  }
+}
+
+void loop_test_file(const Decimal arr[], size_t size) {
+  std::vector<Decimal> values;
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) values.push_back(arr[i] / arr[j]);
+  }
+  run_test<FileTest>(values);
+}
+
+void loop_test_column(const Decimal arr[], size_t size) {
+  std::vector<Decimal> column(arr, arr + size);
+  for (int scale : {0, 5, 28}) {
+    run_test<ColumnTest>(column, scale);
+  }
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      run_test<ColumnTest>(std::vector<Decimal>{arr[i], arr[j], arr[i]});
+    }
+  }
+}
+
+void loop_test_ordered_key(const Decimal arr[], size_t size) {
+  // every key one bit away from the key of a value
+  for (size_t i = 0; i < size; ++i) {
+    for (int bit = 0; bit < 8 * Decimal::kOrderedKeySize; ++bit) {
+      Decimal::OrderedKey key = arr[i].toOrderedKey();
+      key[bit / 8] ^= static_cast<uint8_t>(1 << bit % 8);
+      run_test<OrderedKeyBytesTest>(key);
+    }
+  }
+}
+
+void loop_test_map(const Decimal arr[], size_t size) {
+  // products and quotients repeat values at other scales
+  std::vector<Decimal> keys;
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      keys.push_back(arr[i] * arr[j]);
+      keys.push_back(arr[i] / arr[j]);
+    }
+  }
+  run_test<MapTest>(keys);
+}
+
+void loop_test_sort(const Decimal arr[], size_t size) {
+  // equal values at other scales, and enough copies for the radix sort
+  std::vector<Decimal> values;
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      values.push_back(arr[i] * arr[j]);
+      values.push_back(arr[i] / arr[j]);
+    }
+  }
+  run_test<SortTest>(values);
+  const std::vector<Decimal> copy(values);
+  while (values.size() < 4096) {
+    values.insert(values.end(), copy.begin(), copy.end());
+  }
+  run_test<SortTest>(values);
+}
+
+void loop_test_parallel(const Decimal arr[], size_t size) {
+  std::vector<Decimal> lhs, rhs;
+  for (size_t i = 0; i < 3 * DecimalParallel::kMinPart + size; ++i) {
+    lhs.push_back(arr[i % size]);
+    rhs.push_back(arr[(i / size) % size]);
+  }
+  run_test<ParallelTest>(lhs, rhs);
+}
+
+void loop_test_fma(const Decimal arr[], size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      for (size_t k = 0; k < size; ++k) {
+        run_test<FmaTest>(arr[i], arr[j], arr[k]);
+      }
+    }
+  }
+}
+
+void loop_test_chars(const Decimal arr[], size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    const int length = static_cast<int>(arr[i].toString().size());
+    run_test<ToCharsTest>(arr[i]);
+    run_test<ToCharsTest>(arr[i], length);
+    run_test<ToCharsTest>(arr[i], length - 1);
+    run_test<FromCharsTest>(arr[i].toString(), arr[i]);
+  }
+}
+
+void loop_test_parser(const Decimal arr[], size_t size) {
+  std::string column, lines;
+  for (size_t i = 0; i < size; ++i) {
+    if (i) column += ',';
+    column += arr[i].toString();
+    lines += arr[i].toString() + "\n";
+  }
+  run_test<ParserTest>(column);
+  run_test<ParserTest>(lines, ';');
+}
+
+void loop_test_reader(const Decimal arr[], size_t size) {
+  std::string text;
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      text += (arr[i] * arr[j]).toString() + (j + 1 < size ? "," : "\n");
+    }
+  }
+  for (size_t block_size : {8, 40, 4096}) {
+    run_test<ReaderTest>(text, block_size);
+    run_test<ReaderTest>(text.substr(0, text.size() / 3), block_size);
+  }
+}
+
+void loop_test_double(const Decimal arr[], size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    // only values of at most 15 significant digits survive a double
+    std::string digits = arr[i].toString();
+    digits.erase(std::remove_if(digits.begin(), digits.end(),
+                                [](char c) { return c == '-' || c == '.'; }),
+                 digits.end());
+    digits.erase(0, digits.find_first_not_of('0'));
+    if (digits.size() <= 15) {
+      run_test<ToDoubleTest>(arr[i]);
+    } else {
+      run_test<ToDoubleTest>(arr[i], "from_decimal_to_double");
     }
   }
 }
@@ -66,6 +260,23 @@ int main() try {
 
   // BaseTest::PrintAllResults = true;
   loop_test_decimal(decimal_arr, sizeof(decimal_arr) / sizeof(decimal_arr[0]));
+  loop_test_accumulator(decimal_arr,
+                        sizeof(decimal_arr) / sizeof(decimal_arr[0]));
+  loop_test_batch(decimal_arr, sizeof(decimal_arr) / sizeof(decimal_arr[0]));
+  loop_test_codec(decimal_arr, sizeof(decimal_arr) / sizeof(decimal_arr[0]));
+  loop_test_file(decimal_arr, sizeof(decimal_arr) / sizeof(decimal_arr[0]));
+  loop_test_column(decimal_arr, sizeof(decimal_arr) / sizeof(decimal_arr[0]));
+  loop_test_ordered_key(decimal_arr,
+                        sizeof(decimal_arr) / sizeof(decimal_arr[0]));
+  loop_test_map(decimal_arr, sizeof(decimal_arr) / sizeof(decimal_arr[0]));
+  loop_test_sort(decimal_arr, sizeof(decimal_arr) / sizeof(decimal_arr[0]));
+  loop_test_parallel(decimal_arr,
+                     sizeof(decimal_arr) / sizeof(decimal_arr[0]));
+  loop_test_fma(decimal_arr, sizeof(decimal_arr) / sizeof(decimal_arr[0]));
+  loop_test_chars(decimal_arr, sizeof(decimal_arr) / sizeof(decimal_arr[0]));
+  loop_test_reader(decimal_arr, sizeof(decimal_arr) / sizeof(decimal_arr[0]));
+  loop_test_parser(decimal_arr, sizeof(decimal_arr) / sizeof(decimal_arr[0]));
+  loop_test_double(decimal_arr, sizeof(decimal_arr) / sizeof(decimal_arr[0]));
   loop_test_float(float_arr, sizeof(float_arr) / sizeof(float_arr[0]));
   loop_test_int(int_arr, sizeof(int_arr) / sizeof(int_arr[0]));
 